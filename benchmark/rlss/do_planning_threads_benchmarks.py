@@ -0,0 +1,52 @@
+import os
+import json
+import time
+import subprocess
+
+# measures wall clock duration of simulations with different number of
+# planning threads. each simulation step plans for all robots in parallel.
+
+_2d_solver = "/home/baskin/repos/rlss/cmake-build-release/cplex/2d_sim"
+_3d_solver = "/home/baskin/repos/rlss/cmake-build-release/cplex/3d_sim"
+
+setups = ["ex1", "ex2", "ex3"]
+thread_counts = [1, 2, 4, 8, 16, 32, 64]
+
+results = {}
+
+for setup_name in setups:
+    for thread_count in thread_counts:
+        print(setup_name, thread_count)
+
+        cfgf = open("./configs/" + setup_name + ".json", "r")
+        cfg = json.loads(cfgf.read())
+        cfgf.close()
+
+        cfg["planning_threads"] = thread_count
+        # one thread per robot, speculative rescaling would oversubscribe
+        cfg["speculative_rescaling_count"] = 1
+
+        cfgf = open("config.json", "w")
+        cfgf.write(json.dumps(cfg))
+        cfgf.close()
+
+        dimension = len(cfg["occupancy_grid_step_size"])
+
+        if dimension == 2:
+            solver = _2d_solver
+        elif dimension == 3:
+            solver = _3d_solver
+        else:
+            raise Exception("unknown dimension")
+
+        start = time.time()
+        subprocess.run([solver, "-c", "./config.json"], stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+        results[(setup_name, thread_count)] = time.time() - start
+
+
+print("setup threads seconds speedup")
+for setup_name in setups:
+    sequential = results[(setup_name, 1)]
+    for thread_count in thread_counts:
+        seconds = results[(setup_name, thread_count)]
+        print(setup_name, thread_count, seconds, sequential / seconds)
@@ -50,3 +50,5 @@ target_compile_definitions(
 
 
 add_dependencies(build_rlss_examples 3d_sim)
+
+generate_example(cost_hessian_benchmark)
@@ -0,0 +1,69 @@
+#include <rlss/internal/CostHessian.hpp>
+#include <splx/opt/PiecewiseCurveQPGenerator.hpp>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// compares the duration of adding the integrated squared derivative costs of
+// a problem build with the cached hessians of rlss, which add all lambdas at
+// once, and with splx, which adds one lambda at a time. costs are added
+// after a problem reset the way generate_optimization_problem adds them.
+
+constexpr unsigned int DIM = 3;
+using PiecewiseCurveQPGenerator = splx::PiecewiseCurveQPGenerator<double, DIM>;
+
+template<typename AddCosts>
+double microsecondsPerBuild(
+        PiecewiseCurveQPGenerator& qpgen,
+        unsigned int repetitions,
+        AddCosts add_costs
+) {
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned int r = 0; r < repetitions; r++) {
+        qpgen.resetProblem();
+        add_costs();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count()
+           / repetitions;
+}
+
+int main() {
+    const std::vector<std::pair<unsigned int, double>> lambdas {
+        {1, 1.0}, {2, 2.0}, {3, 1.0}
+    };
+    const unsigned int repetitions = 200;
+
+    std::cout << "degree pieces splx_us cached_us" << std::endl;
+    for(unsigned int degree: {5u, 7u, 9u}) {
+        for(unsigned int pieces: {1u, 4u, 8u, 16u}) {
+            PiecewiseCurveQPGenerator qpgen;
+            std::vector<double> durations;
+            for(unsigned int p = 0; p < pieces; p++) {
+                qpgen.addBezier(degree, 0);
+                durations.push_back(0.5 + 0.1 * p);
+            }
+            qpgen.setPieceMaxParameters(durations);
+
+            double splx_us = microsecondsPerBuild(
+                    qpgen, repetitions,
+                    [&]() {
+                        for(const auto& [k, lambda]: lambdas) {
+                            qpgen.addIntegratedSquaredDerivativeCost(
+                                    k, lambda);
+                        }
+                    });
+            double cached_us = microsecondsPerBuild(
+                    qpgen, repetitions,
+                    [&]() {
+                        rlss::internal::addIntegratedSquaredDerivativeCosts<
+                                double, DIM>(qpgen, lambdas);
+                    });
+
+            std::cout << degree << " " << pieces << " "
+                      << splx_us << " " << cached_us << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
 #include <rlss/OccupancyGrid.hpp>
 #include <rlss/RLSS.hpp>
+#include <rlss/ReplanningTrigger.hpp>
+#include <rlss/ReplanningScheduler.hpp>
 #include <iostream>
 #include "../third_party/cxxopts.hpp"
 #include "../third_party/json.hpp"
@@ -15,6 +17,8 @@
 #include <memory>
 //#include <rlss/internal/LegacyJSONBuilder.hpp>
 #include <rlss/internal/JSONBuilder.hpp>
+#include <rlss/internal/BatchEval.hpp>
+#include <rlss/internal/ThreadPool.hpp>
 #include <rlss/TrajectoryOptimizers/RLSSHardOptimizer.hpp>
 #include <rlss/TrajectoryOptimizers/RLSSSoftOptimizer.hpp>
 #include <rlss/TrajectoryOptimizers/RLSSHardSoftOptimizer.hpp>
@@ -33,6 +37,7 @@ using CollisionShape = rlss::CollisionShape<double, DIM>;
 using StdVectorVectorDIM = OccupancyGrid::StdVectorVectorDIM;
 using VectorDIM = OccupancyGrid::VectorDIM;
 using MatrixDIMDIM = rlss::internal::MatrixRC<double, DIM, DIM>;
+using MatrixDIMX = rlss::internal::MatrixDIMX<double, DIM>;
 using PiecewiseCurveQPGenerator
 = splx::PiecewiseCurveQPGenerator<double, DIM>;
 using PiecewiseCurve = splx::PiecewiseCurve<double, DIM>;
@@ -44,12 +49,16 @@ using RLSSSoftOptimizer = rlss::RLSSSoftOptimizer<double, DIM>;
 using RLSSHardSoftOptimizer = rlss::RLSSHardSoftOptimizer<double, DIM>;
 using RLSSDiscretePathSearcher = rlss::RLSSDiscretePathSearcher<double, DIM>;
 using RLSSValidityChecker = rlss::RLSSValidityChecker<double, DIM>;
+using ReplanningTrigger = rlss::ReplanningTrigger<double, DIM>;
+using ReplanningScheduler = rlss::ReplanningScheduler<double, DIM>;
 using RLSSGoalSelector = rlss::RLSSGoalSelector<double, DIM>;
 using TrajectoryOptimizer = rlss::TrajectoryOptimizer<double, DIM>;
 using DiscretePathSearcher = rlss::DiscretePathSearcher<double, DIM>;
 using ValidityChecker = rlss::ValidityChecker<double, DIM>;
 using GoalSelector = rlss::GoalSelector<double, DIM>;
 using JSONBuilder = rlss::internal::JSONBuilder<double, DIM>;
+using JSONLinesWriter = rlss::internal::JSONLinesWriter;
+using ThreadPool = rlss::internal::ThreadPool;
 
 
 bool allRobotsReachedFinalStates(
@@ -118,6 +127,61 @@ int main(int argc, char* argv[]) {
     double reach_distance = config_json["reach_distance"];
     std::vector<double> occupancy_grid_step_size
             = config_json["occupancy_grid_step_size"];
+    // 0 uses one thread per hardware thread
+    std::size_t planning_threads
+            = config_json.value("planning_threads", std::size_t(0));
+    // whether robots that can not reach each other during the first piece
+    // are left out of robot to robot constraints
+    bool robot_culling = config_json.value("robot_culling", false);
+    // seconds each planning step may take, 0 for no deadline. robots whose
+    // planning hits the deadline keep following their previous trajectory.
+    double planning_deadline = config_json.value("planning_deadline", 0.0);
+    // whether robots plan only when their current trajectory is no longer
+    // safe or stops tracking the original trajectory, or is replanning max
+    // age seconds old
+    bool event_triggered_replanning
+            = config_json.value("event_triggered_replanning", false);
+    double replanning_max_age = config_json.value("replanning_max_age", 1.0);
+    double replanning_max_deviation
+            = config_json.value("replanning_max_deviation", 0.1);
+    // robots share cpu_budget seconds of planning per period, the most
+    // urgent ones plan first
+    nlohmann::json scheduler_json
+            = config_json.value("replanning_scheduler", nlohmann::json());
+    bool scheduled_replanning = scheduler_json.value("enable", false);
+    // per call statistics grow with the run, summaries are kept in
+    // constant memory either way
+    bool statistics_keep_records
+            = config_json.value("statistics_keep_records", false);
+    // whether statistics and visualization are appended to all_stats.jsonl
+    // and vis.jsonl as the simulation runs instead of rewriting all_stats.json
+    // and vis.json every period. tools/scripts/jsonl_to_json.py converts them.
+    bool streaming_output = config_json.value("streaming_output", false);
+    // format of the visualization output, json, cbor or packed_cbor.
+    // vis.cbor is less than half the size of vis.json, packed_cbor
+    // drops the keys of every frame on top of that.
+    std::string vis_format_name
+            = config_json.value("vis_format", std::string("json"));
+    rlss::internal::jsonbuilder::Format vis_format;
+    std::string vis_filename;
+    if(vis_format_name == "json") {
+        vis_format = rlss::internal::jsonbuilder::Format::JSON;
+        vis_filename = "vis.json";
+    } else if(vis_format_name == "cbor") {
+        vis_format = rlss::internal::jsonbuilder::Format::CBOR;
+        vis_filename = "vis.cbor";
+    } else if(vis_format_name == "packed_cbor") {
+        vis_format = rlss::internal::jsonbuilder::Format::PackedCBOR;
+        vis_filename = "vis.cbor";
+    } else {
+        throw std::domain_error(
+                absl::StrCat(
+                        "visualization format ",
+                        vis_format_name,
+                        " not recognized."
+                )
+        );
+    }
 
     OccupancyGrid::Coordinate step_size;
     for(unsigned int i = 0; i < DIM; i++) {
@@ -162,9 +226,15 @@ int main(int argc, char* argv[]) {
 
 
     std::vector<RLSS> planners;
+    // svm solver of the robot to robot hyperplanes computed once per robot
+    // pair in batch planning
+    std::string svm_solver = rlss::QPSolverSelection().svm;
+    // maximum of the maximum velocities of the robots
+    double fleet_maximum_velocity = 0;
     std::vector<std::shared_ptr<CollisionShape>> collision_shapes;
     std::vector<PiecewiseCurve> original_trajectories;
     std::vector<unsigned int> contUpto;
+    std::vector<ReplanningTrigger> replanning_triggers;
 
     // for each robot there is a vector of pairs where each pair
     // is (degree, distribution)
@@ -229,6 +299,10 @@ int main(int argc, char* argv[]) {
                 = config_json.contains("max_rescaling_count")
                   ? config_json["max_rescaling_count"]
                   : robot_json["max_rescaling_count"];
+        unsigned int speculative_rescaling_count
+                = config_json.contains("speculative_rescaling_count")
+                  ? config_json["speculative_rescaling_count"].get<unsigned int>()
+                  : robot_json.value("speculative_rescaling_count", 1u);
         double desired_time_horizon = robot_json["desired_time_horizon"];
         unsigned int continuity_upto_degree
                 = config_json.contains("continuity_upto_degree")
@@ -275,6 +349,14 @@ int main(int argc, char* argv[]) {
 
         collision_shapes.push_back(collision_shape);
 
+        replanning_triggers.emplace_back(
+                collision_shape,
+                original_trajectories.back(),
+                replanning_max_deviation,
+                replanning_max_age,
+                search_step
+        );
+
         nlohmann::json workspace_json;
         if(config_json.contains("workspace")) {
             workspace_json = config_json["workspace"];
@@ -315,6 +397,56 @@ int main(int argc, char* argv[]) {
                   config_json["optimization_obstacle_check_distance"] :
                   robot_json["optimization_obstacle_check_distance"];
 
+        std::string obstacle_constraint_generator_name = "svm";
+        if(config_json.contains("obstacle_constraint_generator")) {
+            obstacle_constraint_generator_name
+                    = config_json["obstacle_constraint_generator"];
+        } else if(robot_json.contains("obstacle_constraint_generator")) {
+            obstacle_constraint_generator_name
+                    = robot_json["obstacle_constraint_generator"];
+        }
+
+        rlss::ObstacleConstraintGenerator obstacle_constraint_generator;
+        if(obstacle_constraint_generator_name == "svm") {
+            obstacle_constraint_generator
+                    = rlss::ObstacleConstraintGenerator::SVM;
+        } else if(obstacle_constraint_generator_name == "safe-corridor") {
+            obstacle_constraint_generator
+                    = rlss::ObstacleConstraintGenerator::SafeCorridor;
+        } else {
+            throw std::domain_error(
+                    absl::StrCat(
+                            "obstacle constraint generator ",
+                            obstacle_constraint_generator_name,
+                            " not recognized."
+                    )
+            );
+        }
+
+        nlohmann::json qp_solvers_json
+                = config_json.contains("qp_solvers") ?
+                  config_json["qp_solvers"] :
+                  (robot_json.contains("qp_solvers") ?
+                   robot_json["qp_solvers"]
+                   : nlohmann::json::object());
+
+        rlss::QPSolverSelection qp_solvers;
+        qp_solvers.hard = qp_solvers_json.value("hard", qp_solvers.hard);
+        qp_solvers.soft = qp_solvers_json.value("soft", qp_solvers.soft);
+        qp_solvers.svm = qp_solvers_json.value("svm", qp_solvers.svm);
+        qp_solvers.lp = qp_solvers_json.value("lp", qp_solvers.lp);
+        svm_solver = qp_solvers.svm;
+
+        bool concurrent_soft_solve
+                = config_json.contains("concurrent_soft_solve") ?
+                  config_json["concurrent_soft_solve"].get<bool>() :
+                  robot_json.value("concurrent_soft_solve", false);
+
+        bool warm_start
+                = config_json.contains("warm_start") ?
+                  config_json["warm_start"].get<bool>() :
+                  robot_json.value("warm_start", false);
+
         nlohmann::json noise_json =
                 config_json.contains("noise") ?
                 config_json["noise"] :
@@ -353,6 +485,8 @@ int main(int argc, char* argv[]) {
                 break;
             }
         }
+        fleet_maximum_velocity
+                = std::max(fleet_maximum_velocity, maximum_velocity);
         auto rlss_discrete_path_searcher
                 = std::make_shared<RLSSDiscretePathSearcher>
                         (
@@ -377,7 +511,11 @@ int main(int argc, char* argv[]) {
                             integrated_squared_derivative_weights,
                             piece_endpoint_cost_weights,
                             soft_optimization_parameters,
-                            optimization_obstacle_check_distance
+                            optimization_obstacle_check_distance,
+                            obstacle_constraint_generator,
+                            qp_solvers,
+                            concurrent_soft_solve,
+                            warm_start
                     );
             trajectory_optimizer
                     = std::static_pointer_cast<TrajectoryOptimizer>(
@@ -392,7 +530,10 @@ int main(int argc, char* argv[]) {
                             integrated_squared_derivative_weights,
                             piece_endpoint_cost_weights,
                             soft_optimization_parameters,
-                            optimization_obstacle_check_distance
+                            optimization_obstacle_check_distance,
+                            obstacle_constraint_generator,
+                            qp_solvers,
+                            warm_start
                     );
             trajectory_optimizer
                     = std::static_pointer_cast<TrajectoryOptimizer>(
@@ -406,7 +547,10 @@ int main(int argc, char* argv[]) {
                             continuity_upto_degree,
                             integrated_squared_derivative_weights,
                             piece_endpoint_cost_weights,
-                            optimization_obstacle_check_distance
+                            optimization_obstacle_check_distance,
+                            obstacle_constraint_generator,
+                            qp_solvers,
+                            warm_start
                     );
             trajectory_optimizer
                     = std::static_pointer_cast<TrajectoryOptimizer>(
@@ -437,12 +581,38 @@ int main(int argc, char* argv[]) {
                 discrete_path_searcher,
                 validity_checker,
                 max_rescaling_count,
-                rescaling_multiplier
+                rescaling_multiplier,
+                speculative_rescaling_count
         );
 
     }
 
+    // robots move towards each other with at most twice the fleet maximum
+    // velocity. pair hyperplanes are precomputed for robots that can reach
+    // each other within a replanning period, the optimizers compute the
+    // others they need for longer first pieces.
+    double robot_hyperplane_distance = std::numeric_limits<double>::infinity();
+    if(robot_culling) {
+        for(RLSS& planner: planners) {
+            planner.setRobotCullingSpeed(2 * fleet_maximum_velocity);
+        }
+        robot_hyperplane_distance
+                = 2 * fleet_maximum_velocity * replanning_period;
+    }
+
     unsigned int num_robots = planners.size();
+    for(RLSS& planner: planners) {
+        planner.setKeepStatisticsRecords(statistics_keep_records);
+    }
+
+    std::shared_ptr<JSONLinesWriter> stats_writer, vis_writer;
+    if(streaming_output) {
+        stats_writer = std::make_shared<JSONLinesWriter>("all_stats.jsonl");
+        vis_writer = std::make_shared<JSONLinesWriter>("vis.jsonl");
+        for(std::size_t i = 0; i < num_robots; i++) {
+            planners[i].streamStatisticsTo(stats_writer, i);
+        }
+    }
 
     std::cout << "num robots: " << num_robots << std::endl;
 
@@ -468,8 +638,25 @@ int main(int argc, char* argv[]) {
     }
     json_builder.setFrameDt(0.01);
     json_builder.addOccupancyGridToCurrentFrame(occupancy_grid);
+    if(streaming_output) {
+        json_builder.streamTo(vis_writer);
+    }
+
+    ReplanningScheduler replanning_scheduler(
+            num_robots,
+            scheduler_json.value("cpu_budget", 0.05),
+            scheduler_json.value("proximity_distance", 1.0),
+            scheduler_json.value("proximity_weight", 1.0),
+            scheduler_json.value("age_weight", 1.0),
+            scheduler_json.value("tracking_error_weight", 10.0)
+    );
+
+    ThreadPool planning_pool(planning_threads);
+    std::cout << "planning threads: " << planning_pool.threadCount()
+              << std::endl;
 
     double current_time = 0;
+    std::vector<std::optional<PiecewiseCurve>> planned_curves(num_robots);
     std::vector<PiecewiseCurve> trajectories(num_robots);
     std::vector<double> trajectory_current_times(num_robots, 0);
 
@@ -485,28 +672,93 @@ int main(int argc, char* argv[]) {
                     = collision_shapes[i]->boundingBox(states[i][0]);
         }
 
-        for(std::size_t i = 0; i < planners.size(); i++) {
-            rlss::debug_message("planning for robot ", i, "...");
-            std::vector<AlignedBox> other_robot_collision_boxes
-                    = robot_collision_boxes;
-            other_robot_collision_boxes.erase(
-                    other_robot_collision_boxes.begin() + i);
-
-//            double cutoff_duration = 100000; // us
-//            auto plan_start_time = std::chrono::steady_clock::now();
-            std::optional<PiecewiseCurve> curve
-                    = planners[i].plan(
-                            current_time,
-                            states[i],
-                            other_robot_collision_boxes,
-                            occupancy_grid
+        // robots plan in parallel against the same snapshot of robot
+        // collision boxes, and the results are merged in robot order below
+        rlss::internal::Deadline deadline;
+        if(planning_deadline > 0) {
+            deadline = rlss::internal::Deadline::after(
+                    std::chrono::duration<double>(planning_deadline));
+        }
+        std::vector<bool> replan;
+        // robots the scheduler must let plan whatever its budget
+        std::vector<bool> safety_critical;
+        if(event_triggered_replanning) {
+            replan.resize(num_robots);
+            safety_critical.resize(num_robots);
+            for(std::size_t i = 0; i < num_robots; i++) {
+                std::vector<AlignedBox> other_robot_collision_boxes;
+                for(std::size_t j = 0; j < num_robots; j++) {
+                    if(j != i) {
+                        other_robot_collision_boxes.push_back(
+                                robot_collision_boxes[j]);
+                    }
+                }
+                // states are at the end of the period of the previous step
+                const rlss::ReplanningReason reason
+                    = replanning_triggers[i].replanningReason(
+                        current_time,
+                        states[i][0],
+                        trajectories[i],
+                        trajectory_current_times[i] + replanning_period,
+                        replanning_period,
+                        occupancy_grid,
+                        other_robot_collision_boxes
                     );
-//            auto plan_end_time = std::chrono::steady_clock::now();
-//            auto planning_duration = std::chrono::duration_cast<std::chrono::microseconds>(
-//                        plan_end_time - plan_start_time
-//                ).count();
+                replan[i] = reason != rlss::ReplanningReason::None;
+                safety_critical[i] = rlss::isSafetyCritical(reason);
+            }
+        }
+        if(scheduled_replanning) {
+            std::vector<double> tracking_errors(num_robots, 0);
+            for(std::size_t i = 0; i < num_robots; i++) {
+                if(trajectories[i].numPieces() > 0) {
+                    tracking_errors[i] = (
+                        trajectories[i].eval(
+                            std::min(
+                                trajectory_current_times[i]
+                                    + replanning_period,
+                                trajectories[i].maxParameter()
+                            ),
+                            0
+                        ) - states[i][0]
+                    ).norm();
+                }
+            }
+            replan = replanning_scheduler.schedule(
+                    current_time,
+                    robot_collision_boxes,
+                    tracking_errors,
+                    occupancy_grid,
+                    replan,
+                    safety_critical
+            );
+        }
+        std::vector<double> planning_durations;
+        planned_curves = RLSS::planBatch(
+                planners,
+                current_time,
+                states,
+                robot_collision_boxes,
+                occupancy_grid,
+                &planning_pool,
+                svm_solver,
+                robot_hyperplane_distance,
+                deadline,
+                replan,
+                &planning_durations
+        );
 
-            if(curve /*&& planning_duration < cutoff_duration*/) {
+        for(std::size_t i = 0; i < planners.size(); i++) {
+            const std::optional<PiecewiseCurve>& curve = planned_curves[i];
+            if(replan.empty() || replan[i]) {
+                replanning_scheduler.planned(
+                        i,
+                        current_time,
+                        planning_durations[i],
+                        curve.has_value()
+                );
+            }
+            if(curve) {
                 rlss::debug_message(
                         rlss::internal::debug::colors::GREEN,
                         "planning successful.",
@@ -514,7 +766,11 @@ int main(int argc, char* argv[]) {
                 );
                 trajectories[i] = *curve;
                 trajectory_current_times[i] = 0;
+                replanning_triggers[i].setLastPlanningTime(current_time);
                 json_builder.addTrajectoryToCurrentFrame(i, trajectories[i]);
+            } else if(!replan.empty() && !replan[i]) {
+                rlss::debug_message("replanning skipped.");
+                trajectory_current_times[i] += replanning_period;
             } else {
                 rlss::debug_message(
                         rlss::internal::debug::colors::RED,
@@ -550,43 +806,66 @@ int main(int argc, char* argv[]) {
         }
 
         json_builder.nextFrame();
+        std::vector<double> frame_times;
         for(double t = 0.01; t < replanning_period - 0.005; t += 0.01) {
+            frame_times.push_back(t);
+        }
+        std::vector<MatrixDIMX> frame_positions(num_robots);
+        for(std::size_t i = 0; i < num_robots; i++) {
+            std::vector<double> params(frame_times.size());
+            for(std::size_t f = 0; f < frame_times.size(); f++) {
+                params[f] = std::min(
+                        trajectory_current_times[i] + frame_times[f],
+                        trajectories[i].maxParameter()
+                );
+            }
+            rlss::internal::batchEval<double, DIM>(
+                    trajectories[i], params, 0, frame_positions[i]);
+        }
+        for(std::size_t f = 0; f < frame_times.size(); f++) {
             for(std::size_t i = 0; i < num_robots; i++) {
                 json_builder.setRobotPositionInCurrentFrame(
                         i,
-                        trajectories[i].eval(
-                                std::min(
-                                        trajectory_current_times[i] + t,
-                                        trajectories[i].maxParameter()
-                                ),
-                                0
-                        )
+                        frame_positions[i].col(f)
                 );
             }
             json_builder.nextFrame();
         }
 
-        json_builder.save("vis.json");
-        rlss::internal::StatisticsStorage<double> all_stats;
-        for(const auto& planner: planners) {
-//        planner.statisticsStorage().save();
-            all_stats += planner.statisticsStorage();
-        }
+        if(!streaming_output) {
+            json_builder.save(vis_filename, vis_format);
+            rlss::internal::StatisticsStorage<double> all_stats;
+            all_stats.setKeepRecords(statistics_keep_records);
+            for(const auto& planner: planners) {
+//            planner.statisticsStorage().save();
+                all_stats += planner.statisticsStorage();
+            }
+            all_stats += replanning_scheduler.statisticsStorage();
 
-        all_stats.save("all_stats.json");
+            all_stats.save("all_stats.json");
+        }
         current_time += replanning_period;
     }
 
 
     rlss::internal::StatisticsStorage<double> all_stats;
+    all_stats.setKeepRecords(statistics_keep_records);
     for(const auto& planner: planners) {
 //        planner.statisticsStorage().save();
         all_stats += planner.statisticsStorage();
     }
+    all_stats += replanning_scheduler.statisticsStorage();
+
+    if(streaming_output) {
+        // records are streamed already, summaries end the file
+        nlohmann::json summary = all_stats.summaryJSON();
+        summary["type"] = "summary";
+        stats_writer->write(summary);
+    } else {
+        all_stats.save("all_stats.json");
 
-    all_stats.save("all_stats.json");
-
-    json_builder.save("vis.json");
+        json_builder.save(vis_filename, vis_format);
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#ifndef RLSS_ASYNC_RLSS_HPP
+#define RLSS_ASYNC_RLSS_HPP
+
+#include <rlss/RLSS.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+
+namespace rlss {
+
+/*
+ * Plans the next replanning period while the robot executes the current
+ * one. Planning for the period starting at start_time starts before
+ * start_time from the state the robot is predicted to be in at
+ * start_time, on a background thread, so that planning latency is hidden
+ * behind execution instead of being added to it.
+ *
+ * The wrapped planner plans one call at a time. A planning requested while
+ * another is in progress runs after it, unless it is stale by the time the
+ * previous one finishes, in which case it is skipped with the Superseded
+ * status. The planner must not be used directly until the last returned
+ * future is ready.
+ */
+template<typename T, unsigned int DIM>
+class AsyncRLSS {
+public:
+    using RLSS_ = RLSS<T, DIM>;
+    using StdVectorVectorDIM = typename RLSS_::StdVectorVectorDIM;
+    using AlignedBox = typename RLSS_::AlignedBox;
+    using OccupancyGrid = typename RLSS_::OccupancyGrid;
+    using PiecewiseCurve = typename RLSS_::PiecewiseCurve;
+    using Deadline = typename RLSS_::Deadline;
+
+    struct Result {
+        typename RLSS_::PlanningResult planning_result;
+        // time the planned trajectory starts at
+        T start_time;
+        // number of planAsync calls and invalidations before this result
+        // is requested
+        std::size_t generation;
+    };
+
+    explicit AsyncRLSS(std::shared_ptr<RLSS_> planner)
+        : m_planner(planner),
+          m_generation(0)
+    {
+
+    }
+
+    AsyncRLSS(const AsyncRLSS&) = delete;
+    AsyncRLSS& operator=(const AsyncRLSS&) = delete;
+
+    ~AsyncRLSS() {
+        if(m_last_planning.valid()) {
+            m_last_planning.wait();
+        }
+    }
+
+    /*
+     * State of a robot following trajectory at parameter t, derivatives
+     * 0 to state_size - 1. Robots stay at the end of their trajectories.
+     */
+    static StdVectorVectorDIM predictState(
+            const PiecewiseCurve& trajectory,
+            T t,
+            std::size_t state_size
+    ) {
+        StdVectorVectorDIM state(state_size);
+        const T param = std::min(
+                std::max(t, T(0)), trajectory.maxParameter());
+        for(std::size_t k = 0; k < state_size; k++) {
+            state[k] = trajectory.eval(param, k);
+        }
+        return state;
+    }
+
+    /*
+     * Starts planning from predicted_state at start_time and returns
+     * without waiting for it. Results of the earlier calls are stale once
+     * this is called. occupancy_grid must not be modified until the
+     * returned future is ready.
+     */
+    std::shared_future<Result> planAsync(
+            T start_time,
+            const StdVectorVectorDIM& predicted_state,
+            const std::vector<AlignedBox>&
+            other_robot_collision_shape_bounding_boxes,
+            const OccupancyGrid& occupancy_grid,
+            const Deadline& deadline = Deadline()
+    ) {
+        const std::size_t generation = ++m_generation;
+
+        m_last_planning = std::async(
+                std::launch::async,
+                [this,
+                 planner = m_planner,
+                 previous_planning = m_last_planning,
+                 start_time,
+                 predicted_state,
+                 other_robot_collision_shape_bounding_boxes,
+                 &occupancy_grid,
+                 deadline,
+                 generation]() mutable {
+                    // the shared state keeps this callable until it is
+                    // destroyed, so the previous planning is released once
+                    // it is done. otherwise each planning would keep all
+                    // earlier ones and their results alive.
+                    if(previous_planning.valid()) {
+                        previous_planning.wait();
+                        previous_planning = std::shared_future<Result>();
+                    }
+                    // a newer planning or an invalidation makes the result
+                    // stale before it is computed
+                    if(generation != m_generation.load()) {
+                        return Result{
+                            typename RLSS_::PlanningResult{
+                                PlanningStatus::Superseded, std::nullopt},
+                            start_time,
+                            generation
+                        };
+                    }
+                    return Result{
+                        planner->plan(
+                                start_time,
+                                predicted_state,
+                                other_robot_collision_shape_bounding_boxes,
+                                occupancy_grid,
+                                deadline
+                        ),
+                        start_time,
+                        generation
+                    };
+                }
+        ).share();
+
+        return m_last_planning;
+    }
+
+    /*
+     * Whether result must not be followed at current_time, either because
+     * a newer planning is started or an invalidation happened after it is
+     * requested, or because the robot is already past its start time.
+     */
+    bool isStale(const Result& result, T current_time) const {
+        return result.generation != m_generation
+               || current_time > result.start_time;
+    }
+
+    /*
+     * Marks the plannings in progress stale, e.g. when the robot deviates
+     * from the trajectory its state is predicted from.
+     */
+    void invalidate() {
+        ++m_generation;
+    }
+
+    // waits for all plannings in progress
+    void wait() const {
+        if(m_last_planning.valid()) {
+            m_last_planning.wait();
+        }
+    }
+
+    std::shared_ptr<RLSS_> planner() const {
+        return m_planner;
+    }
+
+private:
+    std::shared_ptr<RLSS_> m_planner;
+    std::shared_future<Result> m_last_planning;
+    std::atomic<std::size_t> m_generation;
+}; // class AsyncRLSS
+
+} // namespace rlss
+
+#endif // RLSS_ASYNC_RLSS_HPP
@@ -3,6 +3,7 @@
 
 #include <rlss/internal/Util.hpp>
 #include <rlss/OccupancyGrid.hpp>
+#include <rlss/internal/Deadline.hpp>
 
 namespace rlss {
 template<typename T, unsigned int DIM>
@@ -26,6 +27,15 @@ public:
             const OccupancyGrid& occupancy_grid
     ) = 0;
 
+    // deadline of the following calls. implementations give up and return
+    // std::nullopt once it expires.
+    void setDeadline(const internal::Deadline& deadline) {
+        m_deadline = deadline;
+    }
+
+protected:
+    internal::Deadline m_deadline;
+
 };
 }
 
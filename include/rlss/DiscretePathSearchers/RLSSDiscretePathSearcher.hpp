@@ -48,7 +48,8 @@ public:
                         goal_position,
                         occupancy_grid,
                         m_workspace,
-                        m_collision_shape
+                        m_collision_shape,
+                        this->m_deadline
                 );
 
 
@@ -56,9 +57,10 @@ public:
             return std::nullopt;
         }
 
-        StdVectorVectorDIM discrete_path = std::move(*discrete_path_opt);
-
-        discrete_path = rlss::internal::firstSegmentFix<T, DIM>(discrete_path);
+        StdVectorVectorDIM discrete_path;
+        discrete_path.reserve(discrete_path_opt->size() + 1);
+        rlss::internal::firstSegmentFix<T, DIM>(
+                *discrete_path_opt, discrete_path);
 
         T total_path_length = 0;
         for(std::size_t i = 0; i < discrete_path.size() - 1; i++) {
@@ -3,6 +3,7 @@
 
 #include <rlss/internal/Util.hpp>
 #include <rlss/OccupancyGrid.hpp>
+#include <rlss/internal/Deadline.hpp>
 namespace rlss {
 
 template<typename T, unsigned int DIM>
@@ -22,6 +23,15 @@ public:
                     T current_time
             ) = 0;
 
+    // deadline of the following calls. implementations give up and return
+    // std::nullopt once it expires.
+    void setDeadline(const internal::Deadline& deadline) {
+        m_deadline = deadline;
+    }
+
+protected:
+    internal::Deadline m_deadline;
+
 };
 
 } // namespace rlss
@@ -3,6 +3,10 @@
 #include <rlss/GoalSelectors/GoalSelector.hpp>
 #include <splx/curve/PiecewiseCurve.hpp>
 #include <rlss/CollisionShapes/CollisionShape.hpp>
+#include <rlss/internal/BatchEval.hpp>
+#include <rlss/internal/FreeSpaceComponents.hpp>
+#include <algorithm>
+#include <cmath>
 
 
 namespace rlss {
@@ -17,6 +21,8 @@ public:
     using Index = typename OccupancyGrid::Index;
     using AlignedBox = rlss::internal::AlignedBox<T, DIM>;
     using CollisionShape = rlss::CollisionShape<T,DIM>;
+    using FreeSpaceComponents = rlss::internal::FreeSpaceComponents<T, DIM>;
+    using Label = typename FreeSpaceComponents::Label;
 
     RLSSGoalSelector(
         T deshor,
@@ -28,7 +34,8 @@ public:
         m_original_trajectory(origtraj),
         m_workspace(ws),
         m_collision_shape(colsha),
-        m_search_step(search_step)
+        m_search_step(search_step),
+        m_free_space_components(ws, colsha)
     {}
 
     std::optional<std::pair<VectorDIM, T>> select
@@ -37,106 +44,72 @@ public:
             const OccupancyGrid& occupancy_grid,
             T current_time
     ) override {
-//        UnorderedIndexSet reachable_indices
-//                = rlss::internal::BFS<T, DIM>(
-//                        current_position,
-//                        occupancy_grid,
-//                        m_workspace,
-//                        m_collision_shape
-//        );
+        this->updateFreeTimeIntervals(occupancy_grid);
+        this->updateReachableLabels(current_position, occupancy_grid);
 
         T target_time = std::min(
                 current_time + m_desired_horizon,
                 m_original_trajectory.maxParameter()
         );
-        VectorDIM target_position = m_original_trajectory.eval(target_time, 0);
-        bool target_time_valid = false;
-        std::vector<Index> neighbors = occupancy_grid.getNeighbors(
-                target_position
-        );
-        neighbors.push_back(occupancy_grid.getIndex(target_position));
-        for(const Index& neigh_idx: neighbors) {
-            if(
-                /*reachable_indices.find(neigh_idx) != reachable_indices.end()
-                &&*/ rlss::internal::segmentValid<T, DIM>(
-                    occupancy_grid,
-                    m_workspace,
-                    target_position,
-                    neigh_idx,
-                    m_collision_shape
-            )
-                    ) {
-                target_time_valid = true;
-                break;
-            }
-        }
 
-        bool forward = true;
-        long long int step_count = 1;
-        while(
-                !target_time_valid
-                && (target_time + step_count * m_search_step
-                    <= m_original_trajectory.maxParameter()
-                    || target_time - step_count * m_search_step >= 0)
-                ) {
-            T candidate_target_time = target_time;
-            if(forward) {
-                candidate_target_time += step_count * m_search_step;
-            } else {
-                candidate_target_time -= step_count * m_search_step;
+        // candidate times are target_time +- step_count * m_search_step,
+        // tried in the order 0, +1, -1, +2, -2, ... . candidates that are
+        // not in a free time interval of the original trajectory
+        // against the static obstacles are skipped without touching the
+        // grid. remaining candidates are checked against the full grid,
+        // which includes the temporary obstacles, and must be reachable
+        // from the current position.
+        std::optional<long long int> forward_step
+                = this->nextForwardStep(target_time, 0);
+        std::optional<long long int> backward_step
+                = this->nextBackwardStep(target_time, 1);
+
+        while(forward_step || backward_step) {
+            if(this->m_deadline.expired()) {
+                debug_message("goal selection deadline expired");
+                return std::nullopt;
             }
 
-            if(
-                    candidate_target_time >= 0
-                    && candidate_target_time <= m_original_trajectory.maxParameter()
-                    ) {
-                VectorDIM candidate_target_position
-                        = m_original_trajectory.eval(candidate_target_time, 0);
-                std::vector<Index> neighbors = occupancy_grid.getNeighbors(
-                        candidate_target_position
-                );
-                neighbors.push_back(
-                        occupancy_grid.getIndex(candidate_target_position)
-                );
-
-                for(const Index& neigh_idx: neighbors) {
-                    if(
-                        /*reachable_indices.find(neigh_idx)
-                            != reachable_indices.end()
-                        &&*/ rlss::internal::segmentValid<T, DIM>(
-                            occupancy_grid,
-                            m_workspace,
-                            candidate_target_position,
-                            neigh_idx,
-                            m_collision_shape
-                    )
-                            ) {
-                        target_time = candidate_target_time;
-                        target_position = candidate_target_position;
-                        target_time_valid = true;
-                        break;
-                    }
-                }
+            bool forward = forward_step
+                           && (!backward_step
+                               || *forward_step <= *backward_step);
+
+            T candidate_target_time = forward
+                    ? target_time + *forward_step * m_search_step
+                    : target_time - *backward_step * m_search_step;
+            candidate_target_time = std::min(
+                    std::max(candidate_target_time, T(0)),
+                    m_original_trajectory.maxParameter()
+            );
+
+            VectorDIM candidate_target_position
+                    = m_original_trajectory.eval(candidate_target_time, 0);
+
+            if(this->positionValid(
+                    candidate_target_position,
+                    occupancy_grid,
+                    false,
+                    &m_reachable_labels)) {
+                T actual_horizon = candidate_target_time - current_time;
+                return std::make_pair(
+                        candidate_target_position, actual_horizon);
             }
 
             if(forward) {
-                forward = false;
+                forward_step = this->nextForwardStep(
+                        target_time, *forward_step + 1);
             } else {
-                forward = true;
-                step_count++;
+                backward_step = this->nextBackwardStep(
+                        target_time, *backward_step + 1);
             }
         }
 
-        if(!target_time_valid) {
-            return std::nullopt;
-        }
-
-        T actual_horizon = target_time - current_time;
-        return std::make_pair(target_position, actual_horizon);
+        return std::nullopt;
     }
 
     void setOriginalTrajectory(const PiecewiseCurve& origtraj) {
         m_original_trajectory = origtraj;
+        m_free_time_intervals_valid = false;
     }
 private:
     T m_desired_horizon;
@@ -144,6 +117,209 @@ private:
     AlignedBox m_workspace;
     std::shared_ptr<CollisionShape> m_collision_shape;
     T m_search_step;
+
+    // sorted, disjoint time intervals [begin, end] of the original
+    // trajectory during which the robot may not be blocked by the occupied
+    // cells of the grid (temporary obstacles are not considered). computed
+    // by sampling the original trajectory with m_search_step, so free
+    // stretches shorter than m_search_step between two blocked samples
+    // are missed.
+    std::vector<std::pair<T, T>> m_free_time_intervals;
+    bool m_free_time_intervals_valid = false;
+    // OccupancyGrid::cellsId of the occupied cells the intervals are
+    // computed for. overlays of a grid share the cells of the grid.
+    std::uint64_t m_free_time_intervals_cells_id = 0;
+
+    // connected components of the occupied cells of the grid, replaces the
+    // BFS from the current position for reachability checks.
+    FreeSpaceComponents m_free_space_components;
+
+    // labels of the components the robot can move into from the current
+    // position.
+    std::vector<Label> m_reachable_labels;
+
+    // checks whether the robot at position can move to the cell it is in or
+    // to one of its neighbors. if reachable_labels is given, the cell must
+    // also be in one of the given components.
+    bool positionValid(
+            const VectorDIM& position,
+            const OccupancyGrid& occupancy_grid,
+            bool ignore_temporary_obstacles,
+            const std::vector<Label>* reachable_labels = nullptr
+    ) const {
+        std::vector<Index> neighbors = occupancy_grid.getNeighbors(position);
+        neighbors.push_back(occupancy_grid.getIndex(position));
+
+        AlignedBox from_box = m_collision_shape->boundingBox(position);
+        for(const Index& neigh_idx: neighbors) {
+            if(reachable_labels) {
+                std::optional<Label> label
+                        = m_free_space_components.label(neigh_idx);
+                if(!label
+                   || std::find(reachable_labels->begin(),
+                                reachable_labels->end(),
+                                *label) == reachable_labels->end()) {
+                    continue;
+                }
+            }
+
+            if(rlss::internal::segmentValid<T, DIM>(
+                    occupancy_grid,
+                    m_workspace,
+                    from_box,
+                    m_collision_shape->boundingBox(
+                        occupancy_grid.getCenter(neigh_idx)),
+                    ignore_temporary_obstacles)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // computes the labels of the components reachable from the current
+    // position in the same way internal::BFS starts its search. components
+    // ignore the temporary obstacles, so a goal may still be rejected by
+    // the discrete search, but goals in other components of the static
+    // map are never selected.
+    void updateReachableLabels(
+            const VectorDIM& current_position,
+            const OccupancyGrid& occupancy_grid
+    ) {
+        m_free_space_components.update(occupancy_grid);
+
+        std::vector<Index> start_indexes
+                = occupancy_grid.getNeighbors(current_position);
+        start_indexes.push_back(occupancy_grid.getIndex(current_position));
+
+        m_reachable_labels.clear();
+        for(const Index& idx: start_indexes) {
+            if(!rlss::internal::segmentValid<T, DIM>(
+                    occupancy_grid,
+                    m_workspace,
+                    current_position,
+                    idx,
+                    m_collision_shape)) {
+                continue;
+            }
+
+            std::optional<Label> label = m_free_space_components.label(idx);
+            if(label
+               && std::find(m_reachable_labels.begin(),
+                            m_reachable_labels.end(),
+                            *label) == m_reachable_labels.end()) {
+                m_reachable_labels.push_back(*label);
+            }
+        }
+    }
+
+    void updateFreeTimeIntervals(const OccupancyGrid& occupancy_grid) {
+        if(m_free_time_intervals_valid
+           && m_free_time_intervals_cells_id == occupancy_grid.cellsId()) {
+            return;
+        }
+
+        const T max_parameter = m_original_trajectory.maxParameter();
+
+        std::vector<T> sample_times;
+        for(T t = 0; t < max_parameter; t += m_search_step) {
+            sample_times.push_back(t);
+        }
+        sample_times.push_back(max_parameter);
+
+        internal::MatrixDIMX<T, DIM> sample_positions
+                = internal::batchEval<T, DIM>(
+                        m_original_trajectory, sample_times, 0);
+
+        // each valid sample marks the time between its neighboring samples
+        // as free, so that only the candidates strictly between two blocked
+        // samples are skipped.
+        m_free_time_intervals.clear();
+        for(std::size_t i = 0; i < sample_times.size(); i++) {
+            if(!this->positionValid(
+                    sample_positions.col(i), occupancy_grid, true)) {
+                continue;
+            }
+
+            T begin = sample_times[i == 0 ? 0 : i - 1];
+            T end = sample_times[std::min(i + 1, sample_times.size() - 1)];
+            if(!m_free_time_intervals.empty()
+               && m_free_time_intervals.back().second >= begin) {
+                m_free_time_intervals.back().second = end;
+            } else {
+                m_free_time_intervals.emplace_back(begin, end);
+            }
+        }
+
+        m_free_time_intervals_valid = true;
+        m_free_time_intervals_cells_id = occupancy_grid.cellsId();
+
+        debug_message("goal selector computed ",
+                      m_free_time_intervals.size(),
+                      " free time intervals from ",
+                      sample_times.size(),
+                      " samples");
+    }
+
+    // smallest step >= step such that target_time + step * m_search_step is
+    // in a free time interval. std::nullopt if there is no such step.
+    std::optional<long long int> nextForwardStep(
+            T target_time, long long int step) const {
+        auto it = std::lower_bound(
+                m_free_time_intervals.begin(),
+                m_free_time_intervals.end(),
+                target_time + step * m_search_step,
+                [](const std::pair<T, T>& interval, T t) {
+                    return interval.second < t;
+                }
+        );
+
+        for(; it != m_free_time_intervals.end(); ++it) {
+            long long int candidate_step = std::max(
+                    step,
+                    static_cast<long long int>(std::ceil(
+                            (it->first - target_time) / m_search_step))
+            );
+            while(target_time + candidate_step * m_search_step < it->first) {
+                candidate_step++;
+            }
+            if(target_time + candidate_step * m_search_step <= it->second) {
+                return candidate_step;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // smallest step >= step such that target_time - step * m_search_step is
+    // in a free time interval. std::nullopt if there is no such step.
+    std::optional<long long int> nextBackwardStep(
+            T target_time, long long int step) const {
+        auto it = std::upper_bound(
+                m_free_time_intervals.begin(),
+                m_free_time_intervals.end(),
+                target_time - step * m_search_step,
+                [](T t, const std::pair<T, T>& interval) {
+                    return t < interval.first;
+                }
+        );
+
+        while(it != m_free_time_intervals.begin()) {
+            --it;
+            long long int candidate_step = std::max(
+                    step,
+                    static_cast<long long int>(std::ceil(
+                            (target_time - it->second) / m_search_step))
+            );
+            while(target_time - candidate_step * m_search_step > it->second) {
+                candidate_step++;
+            }
+            if(target_time - candidate_step * m_search_step >= it->first) {
+                return candidate_step;
+            }
+        }
+
+        return std::nullopt;
+    }
 };
 
 } // namespace rlss
@@ -12,7 +12,11 @@
 #include <rlss/internal/Util.hpp>
 #include <rlss/CollisionShapes/CollisionShape.hpp>
 #include <qp_wrappers/problem.hpp>
-#include <qp_wrappers/cplex.hpp>
+#include <rlss/internal/QPSolver.hpp>
+#include <rlss/internal/UniqueId.hpp>
+#include <rlss/internal/SpatialHash.hpp>
+#include <cmath>
+#include <optional>
 
 namespace rlss {
 
@@ -47,6 +51,66 @@ public:
 
     }
 
+    /*
+     * Read only view of the occupied cells of base with the temporary
+     * obstacles of base and the given temporary obstacles. Cells are not
+     * copied, so base must outlive the overlay and must not be modified
+     * while the overlay is used. Any number of threads can use their own
+     * overlays of the same base concurrently.
+     *
+     * Temporary obstacles of overlays are indexed with a spatial hash whose
+     * cells are as large as the largest temporary obstacle, so that
+     * occupancy checks and distance iterators only look at the temporary
+     * obstacles near the queried box instead of all of them. Building the
+     * index makes constructing an overlay linear in the number of
+     * temporary obstacles. Grids that are not overlays check their
+     * temporary obstacles linearly.
+     */
+    static OccupancyGrid overlay(
+            const OccupancyGrid& base,
+            const std::vector<AlignedBox>& temporary_obstacles) {
+        OccupancyGrid result(base.m_step_size);
+        result.resetOverlay(base, temporary_obstacles);
+        return result;
+    }
+
+    /*
+     * Makes this grid the overlay of base with the given temporary obstacles
+     * in place. Occupied cells and temporary obstacles of this grid are
+     * discarded. The storage of the temporary obstacles and of their index
+     * is reused, so that a grid kept across planning calls does not
+     * allocate when it is reset to overlays of the same size.
+     */
+    void resetOverlay(
+            const OccupancyGrid& base,
+            const std::vector<AlignedBox>& temporary_obstacles) {
+        if(&base == this || &temporary_obstacles == &m_temporary_obstacles) {
+            throw std::domain_error(
+                "occupancy grid can not be reset to an overlay of itself"
+            );
+        }
+
+        m_step_size = base.m_step_size;
+        m_grid.clear();
+        m_base = base.m_base != nullptr ? base.m_base : &base;
+        m_temporary_obstacles.reserve(
+                base.m_temporary_obstacles.size()
+                + temporary_obstacles.size());
+        m_temporary_obstacles.assign(
+                base.m_temporary_obstacles.begin(),
+                base.m_temporary_obstacles.end());
+        m_temporary_obstacles.insert(
+                m_temporary_obstacles.end(),
+                temporary_obstacles.begin(),
+                temporary_obstacles.end());
+        this->indexTemporaryObstacles();
+    }
+
+    // whether this grid is an overlay whose occupied cells are read only
+    bool isOverlay() const {
+        return m_base != nullptr;
+    }
+
     /*
     * gets the cell index that coordinate is in
     */
@@ -102,7 +166,10 @@ public:
     }
 
     void removeOccupancy(const Index& idx) {
-        m_grid.erase(idx);
+        this->throwIfOverlay();
+        if(m_grid.erase(idx) > 0) {
+            m_cells_id.renew();
+        }
     }
 
     void removeOccupancy(const Coordinate& coord) {
@@ -110,7 +177,10 @@ public:
     }
 
     void setOccupancy(const Index& idx) {
-        m_grid.insert(idx);
+        this->throwIfOverlay();
+        if(m_grid.insert(idx).second) {
+            m_cells_id.renew();
+        }
     }
     
     void setOccupancy(const Coordinate& coord) {
@@ -166,16 +236,9 @@ public:
         return this->fillOccupancy(this->getIndex(min), this->getIndex(max));
     }
 
-    bool isOccupied(const Index& idx) const {        
-        AlignedBox idxBox = this->toBox(idx);
-
-        for(const auto& bbox: m_temporary_obstacles) {
-            if(bbox.intersects(idxBox)) {
-                return true;
-            }
-        }
-
-        return m_grid.find(idx) != m_grid.end();
+    bool isOccupied(const Index& idx) const {
+        return this->isOccupiedByTemporaryObstacles(this->toBox(idx))
+            || this->cells().find(idx) != this->cells().end();
     }
 
     bool isOccupied(const Coordinate& coord) const {
@@ -183,11 +246,23 @@ public:
     }
 
     bool isOccupied(const AlignedBox& box) const {
+        return this->isOccupiedByTemporaryObstacles(box)
+            || this->isOccupiedIgnoringTemporaryObstacles(box);
+    }
+
+    bool isOccupiedByTemporaryObstacles(const AlignedBox& box) const {
+        if(m_temporary_obstacle_index) {
+            return m_temporary_obstacle_index->anyWithin(box, 0);
+        }
         for(const auto& bbox: m_temporary_obstacles) {
             if(bbox.intersects(box))
                 return true;
         }
+        return false;
+    }
 
+    // only checks the occupied cells, temporary obstacles are ignored
+    bool isOccupiedIgnoringTemporaryObstacles(const AlignedBox& box) const {
         Index min = this->getIndex(box.min());
         Index max = this->getIndex(box.max());
 
@@ -197,7 +272,7 @@ public:
         visited.insert(min);
         while(!indexes.empty()) {
             Index& occ = indexes.front();
-            if(m_grid.find(occ) != m_grid.end())
+            if(this->cells().find(occ) != this->cells().end())
                 return true;
 
             for(unsigned int d = 0; d < DIM; d++) {
@@ -234,8 +309,14 @@ public:
         Index min = this->getIndex(box.min());
         Index max = this->getIndex(box.max());
 
-        QPWrappers::CPLEX::Engine<T> cplex;
-        cplex.setFeasibilityTolerance(1e-9);
+        // cplex if the build has it
+        std::unique_ptr<internal::QPSolver<T>> solver
+            = internal::createQPSolver<T>(
+                internal::QPSolverRegistry<T>::instance().contains("cplex")
+                ? "cplex"
+                : "qpoases"
+            );
+        solver->setFeasibilityTolerance(1e-9);
 
 
         std::queue<Index> q;
@@ -274,7 +355,7 @@ public:
             }
 
             typename QPWrappers::Problem<T>::Vector result;
-            auto ret = cplex.init(problem, result);
+            auto ret = solver->init(problem, result);
             if(ret == QPWrappers::OptReturnType::Optimal) {
                 this->setOccupancy(fr);
             }
@@ -327,10 +408,18 @@ public:
 
     void addTemporaryObstacle(const AlignedBox& box) {
         m_temporary_obstacles.push_back(box);
+        if(m_temporary_obstacle_index) {
+            m_temporary_obstacle_index->insert(
+                    m_temporary_obstacles.size() - 1, box);
+        }
     }
 
     void clearTemporaryObstacles() {
         m_temporary_obstacles.clear();
+        if(m_temporary_obstacle_index) {
+            m_temporary_obstacle_index->reset(
+                    m_temporary_obstacle_index->cellSize());
+        }
     }
 
     AlignedBox toBox(const Index& idx) const {
@@ -343,29 +432,49 @@ public:
         return this->toBox(this->getIndex(coord));
     }
 
+    const Coordinate& getStepSize() const {
+        return m_step_size;
+    }
+
     iterator begin() const {
-        return iterator(*this, 0, m_grid.begin());
+        return iterator(*this, 0, this->cells().begin());
     }
 
     iterator end() const {
-        return iterator(*this, m_temporary_obstacles.size(), m_grid.end());
+        return iterator(
+                *this, m_temporary_obstacles.size(), this->cells().end());
     }
 
     distance_iterator begin(const AlignedBox& box, T max_distance) const {
-        return distance_iterator(*this, 0, m_grid.begin(), box, max_distance);
+        return distance_iterator(
+                *this, 0, this->cells().begin(), box, max_distance);
     }
 
     distance_iterator end(const AlignedBox& box, T max_distance) const {
         return distance_iterator(*this, m_temporary_obstacles.size(),
-                m_grid.end(), box, max_distance);
+                this->cells().end(), box, max_distance);
     }
 
     std::size_t size() const {
-        return m_grid.size();
+        return this->cells().size();
     }
 
+    // occupied cells. the set of an overlay is the set of its base.
     const UnorderedIndexSet& getIndexSet() const {
-        return m_grid;
+        return this->cells();
+    }
+
+    /*
+     * Process wide unique identifier of the current set of occupied cells.
+     * Grids get a new one when they are constructed, copied or moved and
+     * each time their occupied cells change. Overlays report the one of
+     * their base, since temporary obstacles do not change the cells. Caches
+     * built from the occupied cells are valid while the identifier is the
+     * same.
+     */
+    std::uint64_t cellsId() const {
+        return m_base != nullptr ? m_base->m_cells_id.value()
+                                 : m_cells_id.value();
     }
 
     friend OccupancyGridIterator<T, DIM>;
@@ -374,8 +483,46 @@ public:
 private:
     Coordinate m_step_size;
     UnorderedIndexSet m_grid;
+    internal::UniqueId m_cells_id;
+
+    // grid whose cells an overlay reads, nullptr if not an overlay
+    const OccupancyGrid* m_base = nullptr;
+
+    const UnorderedIndexSet& cells() const {
+        return m_base != nullptr ? m_base->m_grid : m_grid;
+    }
+
+    void throwIfOverlay() const {
+        if(m_base != nullptr) {
+            throw std::domain_error(
+                "occupied cells of an occupancy grid overlay are read only"
+            );
+        }
+    }
 
     std::vector<AlignedBox> m_temporary_obstacles;
+
+    // temporary obstacles of an overlay by their indexes in
+    // m_temporary_obstacles, empty if not an overlay
+    std::optional<internal::SpatialHash<T, DIM>> m_temporary_obstacle_index;
+
+    void indexTemporaryObstacles() {
+        T cell_size = m_step_size.maxCoeff();
+        for(const auto& bbox: m_temporary_obstacles) {
+            if(!bbox.isEmpty()) {
+                cell_size = std::max(cell_size, bbox.sizes().maxCoeff());
+            }
+        }
+
+        if(m_temporary_obstacle_index) {
+            m_temporary_obstacle_index->reset(cell_size);
+        } else {
+            m_temporary_obstacle_index.emplace(cell_size);
+        }
+        for(std::size_t i = 0; i < m_temporary_obstacles.size(); i++) {
+            m_temporary_obstacle_index->insert(i, m_temporary_obstacles[i]);
+        }
+    }
 }; // class OccupancyGrid
 
 
@@ -403,8 +550,22 @@ public:
             box(bx),
             max_distance(max_distance_to_box)
     {
+        // only the indexed temporary obstacles near the box are visited
+        if(temporary_obstacles_idx < grid.m_temporary_obstacles.size()
+           && grid.m_temporary_obstacle_index
+           && std::isfinite(max_distance)) {
+            grid.m_temporary_obstacle_index->query(
+                    box, max_distance, temporary_obstacle_candidates);
+            use_candidates = true;
+            candidate_idx = 0;
+            temporary_obstacles_idx
+                    = temporary_obstacle_candidates.empty()
+                      ? grid.m_temporary_obstacles.size()
+                      : temporary_obstacle_candidates[0];
+        }
+
         if((temporary_obstacles_idx < grid.m_temporary_obstacles.size()
-              || occupied_idx_iterator != grid.m_grid.end())
+              || occupied_idx_iterator != grid.cells().end())
               && box.exteriorDistance(*(*this)) > max_distance_to_box) {
             operator++();
         }
@@ -417,7 +578,7 @@ public:
             rlss::OccupancyGridIterator<T, DIM>(
                     g,
                     0,
-                    grid.m_grid.begin(),
+                    grid.cells().begin(),
                     bx,
                     max_distance_to_box)
     {
@@ -435,13 +596,21 @@ public:
 
     OccupancyGridDistanceIterator<T,DIM>& operator++() {
         do {
-            if (temporary_obstacles_idx < grid.m_temporary_obstacles.size()) {
+            if (temporary_obstacles_idx < grid.m_temporary_obstacles.size()
+                && use_candidates) {
+                candidate_idx++;
+                temporary_obstacles_idx
+                        = candidate_idx < temporary_obstacle_candidates.size()
+                          ? temporary_obstacle_candidates[candidate_idx]
+                          : grid.m_temporary_obstacles.size();
+            } else if (temporary_obstacles_idx
+                       < grid.m_temporary_obstacles.size()) {
                 temporary_obstacles_idx++;
             } else {
                 occupied_idx_iterator++;
             }
         } while((temporary_obstacles_idx < grid.m_temporary_obstacles.size()
-                 || occupied_idx_iterator != grid.m_grid.end())
+                 || occupied_idx_iterator != grid.cells().end())
                 && box.exteriorDistance(*(*this)) > max_distance);
 
         return *this;
@@ -462,6 +631,12 @@ private:
     T max_distance;
     std::size_t temporary_obstacles_idx;
     typename UnorderedIndexSet::const_iterator occupied_idx_iterator;
+
+    // sorted indexes of the temporary obstacles within max_distance if the
+    // grid indexes its temporary obstacles
+    bool use_candidates = false;
+    std::vector<std::size_t> temporary_obstacle_candidates;
+    std::size_t candidate_idx = 0;
 }; // class OccupancyGridDistanceIterator
 
 template<typename T, unsigned int DIM>
@@ -487,7 +662,7 @@ public:
         rlss::OccupancyGridIterator<T, DIM>(
                 g,
                 0,
-                grid.m_grid.begin())
+                grid.cells().begin())
     {
     }
 
@@ -527,19 +702,28 @@ private:
 
 namespace internal {
 
+// temporary obstacles of the grid are not checked if
+// ignore_temporary_obstacles is set
 template<typename T, unsigned int DIM>
 bool segmentValid(
     const OccupancyGrid<T, DIM>& grid,
     const AlignedBox<T, DIM>& workspace,
     const AlignedBox<T, DIM>& from_box,
-    const AlignedBox<T, DIM>& to_box
+    const AlignedBox<T, DIM>& to_box,
+    bool ignore_temporary_obstacles = false
 ) {
     using AlignedBox = AlignedBox<T, DIM>;
 
     AlignedBox to_box_copy = to_box;
     to_box_copy.extend(from_box);
 
-    return workspace.contains(to_box_copy) && !grid.isOccupied(to_box_copy);
+    if(!workspace.contains(to_box_copy)) {
+        return false;
+    }
+
+    return ignore_temporary_obstacles
+           ? !grid.isOccupiedIgnoringTemporaryObstacles(to_box_copy)
+           : !grid.isOccupied(to_box_copy);
 }
 
 template<typename T, unsigned int DIM>
@@ -8,9 +8,29 @@
 #include <rlss/internal/Util.hpp>
 #include <splx/curve/PiecewiseCurve.hpp>
 #include <rlss/internal/Statistics.hpp>
+#include <rlss/internal/PlannerWorkspace.hpp>
+#include <rlss/internal/ThreadPool.hpp>
+#include <rlss/internal/SVM.hpp>
+#include <rlss/internal/SpatialHash.hpp>
+#include <rlss/internal/Deadline.hpp>
 #include <chrono>
+#include <memory>
 
 namespace rlss {
+
+// how a planning call with a deadline ended
+enum class PlanningStatus {
+    Success,
+    Failure,
+    // the deadline expired before a curve passed the validity checks. the
+    // result has no curve and the robot should keep following the rest of
+    // its previous trajectory.
+    DeadlineReusePrevious,
+    // the planning is not started since a newer one is requested before it
+    // could start. only returned by AsyncRLSS.
+    Superseded
+};
+
 template<typename T, unsigned int DIM>
 class RLSS {
 public:
@@ -26,6 +46,15 @@ public:
     using StatisticsStorage = internal::StatisticsStorage<T>;
     using DurationStatistics = internal::DurationStatistics<T>;
     using SuccessFailureStatistics = internal::SuccessFailureStatistics<T>;
+    using Hyperplane = internal::Hyperplane<T, DIM>;
+    using Deadline = internal::Deadline;
+
+    struct PlanningResult {
+        PlanningStatus status;
+        // set if and only if status is Success. only curves that passed
+        // the validity checks are returned.
+        std::optional<PiecewiseCurve> curve;
+    };
 
     RLSS(
         std::shared_ptr<GoalSelector_> goal_selector,
@@ -33,26 +62,108 @@ public:
         std::shared_ptr<DiscretePathSearcher_> discrete_path_searcher,
         std::shared_ptr<ValidityChecker_> validity_checker,
         unsigned int max_rsca_count,
-        T rsca_mul
+        T rsca_mul,
+        unsigned int speculative_rsca_count = 1
     ) : m_goal_selector(goal_selector),
         m_trajectory_optimizer(trajectory_optimizer),
         m_discrete_path_searcher(discrete_path_searcher),
         m_validity_checker(validity_checker),
         m_maximum_rescaling_count(max_rsca_count),
-        m_rescaling_duration_multipler(rsca_mul)
+        m_rescaling_duration_multipler(rsca_mul),
+        m_speculative_rescaling_count(std::max(speculative_rsca_count, 1u))
     {
-
+        // each speculative rescaling attempt other than the first needs its
+        // own optimizer and validity checker
+        for(unsigned int i = 1; i < m_speculative_rescaling_count; i++) {
+            m_speculative_optimizers.push_back(
+                    m_trajectory_optimizer->clone());
+            m_speculative_validity_checkers.push_back(
+                    m_validity_checker->clone());
+            if(!m_speculative_optimizers.back()
+               || !m_speculative_validity_checkers.back()) {
+                throw std::domain_error(
+                    absl::StrCat(
+                        "speculative temporal rescaling requires ",
+                        "cloneable trajectory optimizer and validity checker"
+                    )
+                );
+            }
+        }
+        if(m_speculative_rescaling_count > 1) {
+            m_speculative_pool = std::make_unique<internal::ThreadPool>(
+                    m_speculative_rescaling_count);
+        }
     }
 
+    /*
+     * Plans using occupancy_grid with the bounding boxes of the other
+     * robots added as temporary obstacles, which are cleared afterwards.
+     */
     std::optional<PiecewiseCurve> plan(
             T current_time,
             const StdVectorVectorDIM& current_robot_state,
             const std::vector<AlignedBox>&
             other_robot_collision_shape_bounding_boxes,
             OccupancyGrid& occupancy_grid) {
+        std::optional<PiecewiseCurve> result = this->plan(
+                current_time,
+                current_robot_state,
+                other_robot_collision_shape_bounding_boxes,
+                static_cast<const OccupancyGrid&>(occupancy_grid)
+        );
+        occupancy_grid.clearTemporaryObstacles();
+        return result;
+    }
+
+    /*
+     * Plans without modifying occupancy_grid. The bounding boxes of the
+     * other robots and dynamic_obstacles are added as temporary obstacles
+     * to an overlay of occupancy_grid that lives for this call only, so
+     * planners of different robots can share one grid from different
+     * threads as long as no thread modifies it.
+     */
+    std::optional<PiecewiseCurve> plan(
+            T current_time,
+            const StdVectorVectorDIM& current_robot_state,
+            const std::vector<AlignedBox>&
+            other_robot_collision_shape_bounding_boxes,
+            const OccupancyGrid& shared_occupancy_grid,
+            const std::vector<AlignedBox>& dynamic_obstacles
+                = std::vector<AlignedBox>()) {
+        return this->plan(
+                current_time,
+                current_robot_state,
+                other_robot_collision_shape_bounding_boxes,
+                shared_occupancy_grid,
+                Deadline(),
+                dynamic_obstacles
+        ).curve;
+    }
 
-        DurationStatistics duration_statistics;
-        SuccessFailureStatistics sf_statistics;
+    /*
+     * Plans like the overload above, stopping once deadline expires. Goal
+     * selection, discrete search, the svm computations and the QP solves of
+     * the trajectory optimizer, and the temporal rescaling loop check the
+     * deadline, so the call returns shortly after it expires. A curve is
+     * returned only if it passed the validity checks before the deadline,
+     * otherwise the status is DeadlineReusePrevious.
+     */
+    PlanningResult plan(
+            T current_time,
+            const StdVectorVectorDIM& current_robot_state,
+            const std::vector<AlignedBox>&
+            other_robot_collision_shape_bounding_boxes,
+            const OccupancyGrid& shared_occupancy_grid,
+            const Deadline& deadline,
+            const std::vector<AlignedBox>& dynamic_obstacles
+                = std::vector<AlignedBox>()) {
+
+        DurationStatistics& duration_statistics
+                = m_planner_workspace.durationStatistics();
+        SuccessFailureStatistics& sf_statistics
+                = m_planner_workspace.sfStatistics();
+        duration_statistics.reset();
+        sf_statistics.reset();
 
 
         auto plan_start_time = std::chrono::steady_clock::now();
@@ -79,14 +190,28 @@ public:
         }
 
 
-        for(const auto& colbox: other_robot_collision_shape_bounding_boxes) {
-            occupancy_grid.addTemporaryObstacle(colbox);
+        std::vector<AlignedBox>& temporary_obstacles = m_temporary_obstacles;
+        temporary_obstacles.assign(
+                other_robot_collision_shape_bounding_boxes.begin(),
+                other_robot_collision_shape_bounding_boxes.end());
+        temporary_obstacles.insert(
+                temporary_obstacles.end(),
+                dynamic_obstacles.begin(),
+                dynamic_obstacles.end());
+        if(!m_occupancy_grid_overlay) {
+            m_occupancy_grid_overlay.emplace(
+                    shared_occupancy_grid.getStepSize());
         }
+        m_occupancy_grid_overlay->resetOverlay(
+                shared_occupancy_grid, temporary_obstacles);
+        const OccupancyGrid& occupancy_grid = *m_occupancy_grid_overlay;
 
         debug_message("current position is ",
                       current_robot_state[0].transpose());
         debug_message("current time is ", current_time);
 
+        this->setDeadline(deadline);
+
         debug_message("goalSelection...");
 
 
@@ -112,8 +237,14 @@ public:
             );
 
             sf_statistics.setGoalSelectionSuccessFail(false);
-            occupancy_grid.clearTemporaryObstacles();
-            return std::nullopt;
+            if(deadline.expired()) {
+                return this->deadlineExpired(
+                        plan_start_time,
+                        duration_statistics,
+                        sf_statistics
+                );
+            }
+            return PlanningResult{PlanningStatus::Failure, std::nullopt};
         } else {
             sf_statistics.setGoalSelectionSuccessFail(true);
             debug_message(
@@ -152,9 +283,15 @@ public:
                     "discreteSearch failed.",
                     internal::debug::colors::RESET
             );
-            occupancy_grid.clearTemporaryObstacles();
             sf_statistics.setDiscreteSearchSuccessFail(false);
-            return std::nullopt;
+            if(deadline.expired()) {
+                return this->deadlineExpired(
+                        plan_start_time,
+                        duration_statistics,
+                        sf_statistics
+                );
+            }
+            return PlanningResult{PlanningStatus::Failure, std::nullopt};
         } else {
             debug_message(
                     internal::debug::colors::GREEN,
@@ -190,76 +327,106 @@ public:
         }
 
         std::optional<PiecewiseCurve> resulting_curve = std::nullopt;
+        bool found_valid = false;
 
-        for(unsigned int c = 0; c < m_maximum_rescaling_count; c++) {
-            debug_message("trajectoryOptimization...");
-            auto trajectory_optimization_start_time
-                = std::chrono::steady_clock::now();
-            resulting_curve =
-                    m_trajectory_optimizer->optimize(
-                            segments,
-                            durations,
-                            other_robot_collision_shape_bounding_boxes,
-                            occupancy_grid,
-                            current_robot_state
-                    );
-            auto trajectory_optimization_end_time
-                = std::chrono::steady_clock::now();
-
-            duration_statistics.addTrajectoryOptimizationDuration(
-                    std::chrono::duration_cast<std::chrono::microseconds>(
-                            trajectory_optimization_end_time
-                            - trajectory_optimization_start_time
-                    ).count()
-            );
+        m_trajectory_optimizer->setPlanningTime(current_time);
+        for(auto& optimizer: m_speculative_optimizers) {
+            optimizer->setPlanningTime(current_time);
+        }
 
-            if(resulting_curve == std::nullopt) {
-                debug_message(
-                        internal::debug::colors::RED,
-                        "trajectoryOptimization failed.",
-                        internal::debug::colors::RESET
-                );
-                sf_statistics.addTrajectoryOptimizationSuccessFail(false);
-            } else {
-                debug_message(
-                        internal::debug::colors::GREEN,
-                        "trajectoryOptimization success.",
-                        internal::debug::colors::RESET
-                );
-                sf_statistics.addTrajectoryOptimizationSuccessFail(true);
+        // rescaling attempts are made in waves of m_speculative_rescaling_count
+        // attempts run in parallel. durations of the attempts are computed
+        // the same way the sequential loop does, and the first valid attempt
+        // is used, so the result does not depend on the wave size.
+        for(unsigned int c = 0; c < m_maximum_rescaling_count;
+                c += m_speculative_rescaling_count) {
+            if(deadline.expired()) {
+                break;
             }
 
-            bool is_valid;
-            if(resulting_curve != std::nullopt) {
-                auto validity_checker_start_time = std::chrono::steady_clock::now();
-                is_valid = m_validity_checker->isValid(*resulting_curve);
-                auto validity_checker_end_time = std::chrono::steady_clock::now();
-                duration_statistics.addValidityCheckDuration(
-                        std::chrono::duration_cast<std::chrono::microseconds>(
-                                validity_checker_end_time -
-                                validity_checker_start_time
-                        ).count()
-                );
-            }
+            const unsigned int wave_size = std::min(
+                    m_speculative_rescaling_count,
+                    m_maximum_rescaling_count - c);
 
-            if( resulting_curve == std::nullopt
-                || !is_valid)
-            {
-                debug_message("doing temporal rescaling...");
+            std::vector<std::vector<T>>& wave_durations
+                    = m_planner_workspace.durationBuffers(wave_size);
+            for(unsigned int i = 0; i < wave_size; i++) {
+                wave_durations[i].assign(durations.begin(), durations.end());
                 for(auto& dur : durations) {
                     dur *= m_rescaling_duration_multipler;
                 }
-            } else {
-                debug_message(
-                        internal::debug::colors::GREEN,
-                        "does not need temporal rescaling.",
-                        internal::debug::colors::RESET
+            }
+
+            // attempts are made in place in the attempts of the previous
+            // waves and calls
+            std::vector<RescalingAttempt>& attempts = m_rescaling_attempts;
+            if(attempts.size() < wave_size) {
+                attempts.resize(wave_size);
+            }
+
+            // attempt i uses the trajectory optimizer and validity checker
+            // for i = 0 and the speculative ones i - 1 otherwise. attempts
+            // of a wave run on the threads of the speculative pool, which
+            // are kept across calls. the job captures only this and wave,
+            // so that it is stored in the std::function without allocating.
+            const RescalingWave wave{
+                segments,
+                wave_durations,
+                other_robot_collision_shape_bounding_boxes,
+                occupancy_grid,
+                current_robot_state,
+                attempts
+            };
+            auto attempt_rescaling = [this, &wave](std::size_t i) {
+                attemptRescaling(
+                        wave.attempts[i],
+                        i == 0 ? *m_trajectory_optimizer
+                               : *m_speculative_optimizers[i - 1],
+                        i == 0 ? *m_validity_checker
+                               : *m_speculative_validity_checkers[i - 1],
+                        wave.segments,
+                        wave.durations[i],
+                        wave.other_robot_collision_shape_bounding_boxes,
+                        wave.occupancy_grid,
+                        wave.current_robot_state
                 );
-                break; // curve is valid
+            };
+            if(m_speculative_pool) {
+                m_speculative_pool->parallelFor(wave_size, attempt_rescaling);
+            } else {
+                attempt_rescaling(0);
+            }
+
+            for(unsigned int i = 0; i < wave_size; i++) {
+                RescalingAttempt& attempt = attempts[i];
+                recordRescalingAttempt(
+                        attempt, duration_statistics, sf_statistics);
+                resulting_curve = std::move(attempt.curve);
+
+                if(attempt.valid) {
+                    debug_message(
+                            internal::debug::colors::GREEN,
+                            "does not need temporal rescaling.",
+                            internal::debug::colors::RESET
+                    );
+                    found_valid = true;
+                    break; // curve is valid
+                }
+                debug_message("doing temporal rescaling...");
+            }
+
+            if(found_valid) {
+                break;
             }
         }
 
-        occupancy_grid.clearTemporaryObstacles();
+        if(!found_valid && deadline.expired()) {
+            return this->deadlineExpired(
+                    plan_start_time,
+                    duration_statistics,
+                    sf_statistics
+            );
+        }
 
         auto plan_end_time = std::chrono::steady_clock::now();
         duration_statistics.setPlanningDuration(
@@ -279,7 +446,7 @@ public:
             sf_statistics.setPlanningSuccessFail(false);
             statistics_storage.add(sf_statistics);
             statistics_storage.add(duration_statistics);
-            return std::nullopt;
+            return PlanningResult{PlanningStatus::Failure, std::nullopt};
         }
         else {
             debug_message(
@@ -290,7 +457,258 @@ public:
             sf_statistics.setPlanningSuccessFail(true);
             statistics_storage.add(sf_statistics);
             statistics_storage.add(duration_statistics);
-            return resulting_curve;
+
+            m_trajectory_optimizer->setPreviousPlan(
+                    current_time, *resulting_curve);
+            for(auto& optimizer: m_speculative_optimizers) {
+                optimizer->setPreviousPlan(current_time, *resulting_curve);
+            }
+
+            return PlanningResult{
+                    PlanningStatus::Success, std::move(resulting_curve)};
+        }
+    }
+
+    /*
+     * Plans for all robots of a fleet at once. planners[i] plans for robot i
+     * with state robot_states[i] and collision shape bounding box
+     * robot_collision_shape_bounding_boxes[i] against the bounding boxes of
+     * all other robots. The separating hyperplane of each robot pair is
+     * computed once and negated for the partner instead of being computed
+     * by both robots in each of their rescaling attempts. Only pairs of
+     * robots whose bounding boxes are at most hyperplane_distance apart are
+     * precomputed, found with a spatial hash of the bounding boxes; the
+     * optimizers compute the hyperplanes of farther robots they do not
+     * cull themselves. Planning of the robots is dispatched to pool if it
+     * is given. Pair hyperplanes are not computed and robots stop planning
+     * once deadline expires. If replan is not empty, only robots i with
+     * replan[i] set plan, e.g. in event triggered replanning. If
+     * planning_durations is given, it is set to the wall clock seconds
+     * each robot plans for, 0 for robots that do not plan. Returns the
+     * plan of each robot, std::nullopt if the robot does not plan, planning
+     * fails for it, or its deadline expires.
+     */
+    static std::vector<std::optional<PiecewiseCurve>> planBatch(
+            std::vector<RLSS>& planners,
+            T current_time,
+            const std::vector<StdVectorVectorDIM>& robot_states,
+            const std::vector<AlignedBox>&
+            robot_collision_shape_bounding_boxes,
+            const OccupancyGrid& occupancy_grid,
+            internal::ThreadPool* pool = nullptr,
+            const std::string& svm_solver = QPSolverSelection().svm,
+            T hyperplane_distance = std::numeric_limits<T>::infinity(),
+            const Deadline& deadline = Deadline(),
+            const std::vector<bool>& replan = std::vector<bool>(),
+            std::vector<T>* planning_durations = nullptr
+    ) {
+        const std::size_t num_robots = planners.size();
+        if(robot_states.size() != num_robots
+           || robot_collision_shape_bounding_boxes.size() != num_robots
+           || (!replan.empty() && replan.size() != num_robots)) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "batch planning needs a state and a bounding box for ",
+                    "each planner, planners: ",
+                    num_robots,
+                    ", states: ",
+                    robot_states.size(),
+                    ", bounding boxes: ",
+                    robot_collision_shape_bounding_boxes.size(),
+                    ", replan flags: ",
+                    replan.size()
+                )
+            );
+        }
+
+        if(planning_durations != nullptr) {
+            planning_durations->assign(num_robots, T(0));
+        }
+
+        auto plans = [&replan](std::size_t i) {
+            return replan.empty() || replan[i];
+        };
+
+        auto parallel_for = [pool](
+                std::size_t count,
+                const std::function<void(std::size_t)>& fn) {
+            if(pool != nullptr) {
+                pool->parallelFor(count, fn);
+            } else {
+                for(std::size_t i = 0; i < count; i++) {
+                    fn(i);
+                }
+            }
+        };
+
+        std::vector<StdVectorVectorDIM> corners;
+        corners.reserve(num_robots);
+        for(const AlignedBox& box: robot_collision_shape_bounding_boxes) {
+            corners.push_back(internal::cornerPoints<T, DIM>(box));
+        }
+
+        // pairs (i, j), i < j, whose hyperplanes are precomputed
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        if(std::isfinite(hyperplane_distance)) {
+            // cells at least as large as the boxes keep each box in at
+            // most 2^DIM cells, and at least as large as the query distance
+            // keep each query within the neighboring cells
+            T cell_size = std::max(hyperplane_distance, T(1e-3));
+            for(const AlignedBox& box: robot_collision_shape_bounding_boxes) {
+                cell_size = std::max(cell_size, box.sizes().maxCoeff());
+            }
+            internal::SpatialHash<T, DIM> spatial_hash(cell_size);
+            for(std::size_t i = 0; i < num_robots; i++) {
+                spatial_hash.insert(
+                        i, robot_collision_shape_bounding_boxes[i]);
+            }
+            std::vector<std::size_t> neighbors;
+            for(std::size_t i = 0; i < num_robots; i++) {
+                spatial_hash.query(
+                        robot_collision_shape_bounding_boxes[i],
+                        hyperplane_distance,
+                        neighbors);
+                for(std::size_t j: neighbors) {
+                    if(j > i && (plans(i) || plans(j))) {
+                        pairs.emplace_back(i, j);
+                    }
+                }
+            }
+        } else {
+            pairs.reserve(num_robots * num_robots / 2);
+            for(std::size_t i = 0; i < num_robots; i++) {
+                for(std::size_t j = i + 1; j < num_robots; j++) {
+                    if(plans(i) || plans(j)) {
+                        pairs.emplace_back(i, j);
+                    }
+                }
+            }
+        }
+
+        // svm hyperplane separating robot i from robot j of each pair.
+        // robots of pairs for which svm fails compute their hyperplanes
+        // themselves so that they fail the same way as in plan.
+        std::vector<std::optional<Hyperplane>> pair_hyperplanes(pairs.size());
+        parallel_for(pairs.size(), [&](std::size_t p) {
+            if(deadline.expired()) {
+                pair_hyperplanes[p] = std::nullopt;
+                return;
+            }
+            try {
+                pair_hyperplanes[p] = internal::svm<T, DIM>(
+                        corners[pairs[p].first],
+                        corners[pairs[p].second],
+                        svm_solver
+                );
+            } catch(const std::runtime_error&) {
+                pair_hyperplanes[p] = std::nullopt;
+            }
+        });
+
+        // pairs of each robot with the index of the partner, sorted by the
+        // partner
+        std::vector<std::vector<std::pair<std::size_t, std::size_t>>>
+                robot_pairs(num_robots);
+        for(std::size_t p = 0; p < pairs.size(); p++) {
+            robot_pairs[pairs[p].first].emplace_back(pairs[p].second, p);
+            robot_pairs[pairs[p].second].emplace_back(pairs[p].first, p);
+        }
+        for(auto& partner_pairs: robot_pairs) {
+            std::sort(partner_pairs.begin(), partner_pairs.end());
+        }
+
+        std::vector<std::optional<PiecewiseCurve>> curves(num_robots);
+        parallel_for(num_robots, [&](std::size_t i) {
+            if(!plans(i)) {
+                return;
+            }
+
+            const VectorDIM& position = robot_states[i][0];
+            const AlignedBox& box = robot_collision_shape_bounding_boxes[i];
+
+            std::vector<AlignedBox> other_robot_boxes;
+            std::vector<std::optional<Hyperplane>> hyperplanes;
+            other_robot_boxes.reserve(num_robots);
+            hyperplanes.reserve(num_robots);
+            auto partner_pair = robot_pairs[i].begin();
+            for(std::size_t j = 0; j < num_robots; j++) {
+                if(j == i) {
+                    continue;
+                }
+                other_robot_boxes.push_back(
+                        robot_collision_shape_bounding_boxes[j]);
+                hyperplanes.emplace_back(std::nullopt);
+
+                if(partner_pair == robot_pairs[i].end()
+                   || partner_pair->first != j) {
+                    continue;
+                }
+                const std::optional<Hyperplane>& pair_hyperplane
+                        = pair_hyperplanes[partner_pair->second];
+                partner_pair++;
+                if(!pair_hyperplane) {
+                    continue;
+                }
+                Hyperplane hyperplane = i < j
+                        ? *pair_hyperplane
+                        : Hyperplane(-pair_hyperplane->normal(),
+                                     -pair_hyperplane->offset());
+                hyperplanes.back() = internal::shiftHyperplane<T, DIM>(
+                        position, box, hyperplane);
+            }
+
+            RLSS& planner = planners[i];
+            planner.setRobotSafetyHyperplanes(hyperplanes);
+            auto plan_start_time = std::chrono::steady_clock::now();
+            try {
+                PlanningResult result = planner.plan(
+                        current_time,
+                        robot_states[i],
+                        other_robot_boxes,
+                        occupancy_grid,
+                        deadline
+                );
+                if(result.status == PlanningStatus::Success) {
+                    curves[i] = std::move(result.curve);
+                }
+            } catch(...) {
+                planner.clearRobotSafetyHyperplanes();
+                throw;
+            }
+            planner.clearRobotSafetyHyperplanes();
+            if(planning_durations != nullptr) {
+                (*planning_durations)[i] = std::chrono::duration<T>(
+                        std::chrono::steady_clock::now() - plan_start_time
+                ).count();
+            }
+        });
+
+        return curves;
+    }
+
+    // robot to robot safety hyperplanes the optimizers use in the following
+    // plan calls, one for each other robot. optimizers compute the ones
+    // that are std::nullopt.
+    void setRobotSafetyHyperplanes(
+            const std::vector<std::optional<Hyperplane>>& hyperplanes) {
+        m_trajectory_optimizer->setRobotSafetyHyperplanes(hyperplanes);
+        for(auto& optimizer: m_speculative_optimizers) {
+            optimizer->setRobotSafetyHyperplanes(hyperplanes);
+        }
+    }
+
+    void clearRobotSafetyHyperplanes() {
+        m_trajectory_optimizer->clearRobotSafetyHyperplanes();
+        for(auto& optimizer: m_speculative_optimizers) {
+            optimizer->clearRobotSafetyHyperplanes();
+        }
+    }
+
+    // see TrajectoryOptimizer::setRobotCullingSpeed
+    void setRobotCullingSpeed(T speed) {
+        m_trajectory_optimizer->setRobotCullingSpeed(speed);
+        for(auto& optimizer: m_speculative_optimizers) {
+            optimizer->setRobotCullingSpeed(speed);
         }
     }
 
@@ -298,7 +716,155 @@ public:
         return statistics_storage;
     }
 
+    // see StatisticsStorage::setKeepRecords
+    void setKeepStatisticsRecords(bool keep) {
+        statistics_storage.setKeepRecords(keep);
+    }
+
+    // see StatisticsStorage::streamTo
+    void streamStatisticsTo(
+            std::shared_ptr<internal::JSONLinesWriter> writer,
+            std::size_t source
+    ) {
+        statistics_storage.streamTo(std::move(writer), source);
+    }
+
 private:
+    // deadline the components check in the following calls
+    void setDeadline(const Deadline& deadline) {
+        m_goal_selector->setDeadline(deadline);
+        m_discrete_path_searcher->setDeadline(deadline);
+        m_trajectory_optimizer->setDeadline(deadline);
+        for(auto& optimizer: m_speculative_optimizers) {
+            optimizer->setDeadline(deadline);
+        }
+    }
+
+    PlanningResult deadlineExpired(
+            std::chrono::steady_clock::time_point plan_start_time,
+            DurationStatistics& duration_statistics,
+            SuccessFailureStatistics& sf_statistics
+    ) {
+        auto plan_end_time = std::chrono::steady_clock::now();
+        duration_statistics.setPlanningDuration(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                    plan_end_time - plan_start_time
+            ).count()
+        );
+
+        debug_message(
+                internal::debug::colors::RED,
+                "result: deadline expired, reuse previous trajectory",
+                internal::debug::colors::RESET
+        );
+        sf_statistics.setPlanningSuccessFail(false);
+        sf_statistics.setDeadlineHit(true);
+        statistics_storage.add(sf_statistics);
+        statistics_storage.add(duration_statistics);
+
+        return PlanningResult{
+                PlanningStatus::DeadlineReusePrevious, std::nullopt};
+    }
+
+    // result of optimizing and validating one temporal rescaling attempt
+    struct RescalingAttempt {
+        std::optional<PiecewiseCurve> curve;
+        bool valid = false;
+        T trajectory_optimization_duration = 0;
+        T validity_check_duration = 0;
+        internal::SolverDurations<T> solver_durations;
+    };
+
+    // inputs of the rescaling attempts of a wave, durations and attempts
+    // indexed by attempt
+    struct RescalingWave {
+        const StdVectorVectorDIM& segments;
+        const std::vector<std::vector<T>>& durations;
+        const std::vector<AlignedBox>&
+                other_robot_collision_shape_bounding_boxes;
+        const OccupancyGrid& occupancy_grid;
+        const StdVectorVectorDIM& current_robot_state;
+        std::vector<RescalingAttempt>& attempts;
+    };
+
+    // overwrites attempt, reusing the storage of its solver durations
+    static void attemptRescaling(
+            RescalingAttempt& attempt,
+            TrajectoryOptimizer_& trajectory_optimizer,
+            ValidityChecker_& validity_checker,
+            const StdVectorVectorDIM& segments,
+            const std::vector<T>& durations,
+            const std::vector<AlignedBox>&
+            other_robot_collision_shape_bounding_boxes,
+            const OccupancyGrid& occupancy_grid,
+            const StdVectorVectorDIM& current_robot_state
+    ) {
+        attempt.valid = false;
+        attempt.validity_check_duration = 0;
+
+        debug_message("trajectoryOptimization...");
+        auto trajectory_optimization_start_time
+            = std::chrono::steady_clock::now();
+        attempt.curve =
+                trajectory_optimizer.optimize(
+                        segments,
+                        durations,
+                        other_robot_collision_shape_bounding_boxes,
+                        occupancy_grid,
+                        current_robot_state
+                );
+        auto trajectory_optimization_end_time
+            = std::chrono::steady_clock::now();
+
+        attempt.trajectory_optimization_duration
+            = std::chrono::duration_cast<std::chrono::microseconds>(
+                    trajectory_optimization_end_time
+                    - trajectory_optimization_start_time
+              ).count();
+        attempt.solver_durations = trajectory_optimizer.solverDurations();
+
+        if(attempt.curve != std::nullopt) {
+            auto validity_checker_start_time = std::chrono::steady_clock::now();
+            attempt.valid = validity_checker.isValid(*attempt.curve);
+            auto validity_checker_end_time = std::chrono::steady_clock::now();
+            attempt.validity_check_duration
+                = std::chrono::duration_cast<std::chrono::microseconds>(
+                        validity_checker_end_time -
+                        validity_checker_start_time
+                  ).count();
+        }
+    }
+
+    static void recordRescalingAttempt(
+            const RescalingAttempt& attempt,
+            DurationStatistics& duration_statistics,
+            SuccessFailureStatistics& sf_statistics
+    ) {
+        duration_statistics.addTrajectoryOptimizationDuration(
+                attempt.trajectory_optimization_duration);
+        for(const auto& [solver, duration]: attempt.solver_durations) {
+            duration_statistics.addSolverDuration(solver, duration);
+        }
+
+        if(attempt.curve == std::nullopt) {
+            debug_message(
+                    internal::debug::colors::RED,
+                    "trajectoryOptimization failed.",
+                    internal::debug::colors::RESET
+            );
+            sf_statistics.addTrajectoryOptimizationSuccessFail(false);
+        } else {
+            debug_message(
+                    internal::debug::colors::GREEN,
+                    "trajectoryOptimization success.",
+                    internal::debug::colors::RESET
+            );
+            sf_statistics.addTrajectoryOptimizationSuccessFail(true);
+            duration_statistics.addValidityCheckDuration(
+                    attempt.validity_check_duration);
+        }
+    }
+
     std::shared_ptr<GoalSelector_> m_goal_selector;
     std::shared_ptr<TrajectoryOptimizer_> m_trajectory_optimizer;
     std::shared_ptr<DiscretePathSearcher_> m_discrete_path_searcher;
@@ -307,7 +873,22 @@ private:
     unsigned int m_maximum_rescaling_count;
     T m_rescaling_duration_multipler;
 
+    // number of temporal rescaling attempts run in parallel
+    unsigned int m_speculative_rescaling_count;
+    std::vector<std::shared_ptr<TrajectoryOptimizer_>> m_speculative_optimizers;
+    std::vector<std::shared_ptr<ValidityChecker_>>
+            m_speculative_validity_checkers;
+    // runs the attempts of a wave if m_speculative_rescaling_count > 1
+    std::unique_ptr<internal::ThreadPool> m_speculative_pool;
+
     StatisticsStorage statistics_storage;
+
+    // scratch buffers of plan kept across calls
+    internal::PlannerWorkspace<T> m_planner_workspace;
+    std::vector<RescalingAttempt> m_rescaling_attempts;
+    std::vector<AlignedBox> m_temporary_obstacles;
+    // overlay of the grid of the last call, reset in place by each call
+    std::optional<OccupancyGrid> m_occupancy_grid_overlay;
 }; // class RLSS
 } // namespace rlss
 
@@ -0,0 +1,258 @@
+#ifndef RLSS_REPLANNING_SCHEDULER_HPP
+#define RLSS_REPLANNING_SCHEDULER_HPP
+
+#include <rlss/internal/Util.hpp>
+#include <rlss/internal/SpatialHash.hpp>
+#include <rlss/internal/Statistics.hpp>
+#include <rlss/OccupancyGrid.hpp>
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace rlss {
+
+/*
+ * Chooses which robots of a fleet replan in a replanning period when the
+ * fleet shares a planning budget. Robots are ranked by urgency, a weighted
+ * sum of
+ *  - proximity: how far within proximity distance the robot is to the
+ *    closest other robot or occupied cell, 0 outside and 1 at contact,
+ *  - age: seconds since the robot last planned successfully,
+ *  - tracking error: distance between the robot and its trajectory,
+ * and the most urgent robots plan while the sum of their expected planning
+ * durations fits in the budget. The others keep following their current
+ * trajectories. The budget only postpones replans that keep trajectories
+ * fresh: robots that must replan to stay safe, and robots that have not
+ * planned yet, always plan. Expected planning durations are moving
+ * averages of the durations reported by planned.
+ */
+template<typename T, unsigned int DIM>
+class ReplanningScheduler {
+public:
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+    using OccupancyGrid = rlss::OccupancyGrid<T, DIM>;
+    using StatisticsStorage = internal::StatisticsStorage<T>;
+
+    // cpu_budget is the planning seconds of all robots in one period
+    ReplanningScheduler(
+            std::size_t num_robots,
+            T cpu_budget,
+            T proximity_distance,
+            T proximity_weight,
+            T age_weight,
+            T tracking_error_weight
+    ) : m_cpu_budget(cpu_budget),
+        m_proximity_distance(proximity_distance),
+        m_proximity_weight(proximity_weight),
+        m_age_weight(age_weight),
+        m_tracking_error_weight(tracking_error_weight),
+        m_last_planning_times(num_robots),
+        m_expected_durations(num_robots, T(0))
+    {
+        if(!(proximity_distance > 0)) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "scheduler proximity distance must be positive, given: ",
+                    proximity_distance
+                )
+            );
+        }
+    }
+
+    /*
+     * Urgency of each robot with collision shape bounding box
+     * robot_collision_shape_bounding_boxes[i] and distance
+     * tracking_errors[i] to its trajectory at current_time. Robots that
+     * have not planned yet are infinitely urgent.
+     */
+    std::vector<T> urgencies(
+            T current_time,
+            const std::vector<AlignedBox>&
+            robot_collision_shape_bounding_boxes,
+            const std::vector<T>& tracking_errors,
+            const OccupancyGrid& occupancy_grid
+    ) const {
+        const std::size_t num_robots = m_last_planning_times.size();
+        this->checkSize(robot_collision_shape_bounding_boxes.size(),
+                        "bounding boxes");
+        this->checkSize(tracking_errors.size(), "tracking errors");
+
+        internal::SpatialHash<T, DIM> spatial_hash(m_proximity_distance);
+        for(std::size_t i = 0; i < num_robots; i++) {
+            spatial_hash.insert(i, robot_collision_shape_bounding_boxes[i]);
+        }
+
+        std::vector<T> result(num_robots);
+        std::vector<std::size_t> neighbors;
+        for(std::size_t i = 0; i < num_robots; i++) {
+            if(!m_last_planning_times[i]) {
+                result[i] = std::numeric_limits<T>::infinity();
+                continue;
+            }
+
+            const AlignedBox& box = robot_collision_shape_bounding_boxes[i];
+            T clearance = m_proximity_distance;
+            spatial_hash.query(box, m_proximity_distance, neighbors);
+            for(std::size_t j: neighbors) {
+                if(j != i) {
+                    clearance = std::min(
+                            clearance,
+                            box.exteriorDistance(
+                                robot_collision_shape_bounding_boxes[j]));
+                }
+            }
+            for(
+                auto it = occupancy_grid.begin(box, m_proximity_distance);
+                it != occupancy_grid.end(box, m_proximity_distance);
+                ++it
+            ) {
+                clearance = std::min(clearance, box.exteriorDistance(*it));
+            }
+
+            const T proximity = 1 - clearance / m_proximity_distance;
+            const T age = current_time - *m_last_planning_times[i];
+            result[i] = m_proximity_weight * proximity
+                        + m_age_weight * age
+                        + m_tracking_error_weight * tracking_errors[i];
+        }
+
+        return result;
+    }
+
+    /*
+     * Robots that plan at current_time, chosen among the robots i with
+     * candidates[i] set, all robots if candidates is empty.
+     *
+     * Candidates i with safety_critical[i] set, e.g. the ones for which
+     * isSafetyCritical(ReplanningTrigger::replanningReason) holds, and
+     * candidates that have not planned yet always plan, even over the
+     * budget. Their expected durations are used first. The other candidates
+     * plan in order of urgency if their expected durations fit in the rest
+     * of the budget. Candidates that do not fit are skipped, and less urgent
+     * ones that fit still plan. If no robot plans otherwise, the most urgent
+     * candidate plans. Records the age of the plan of each robot in the
+     * statistics.
+     */
+    std::vector<bool> schedule(
+            T current_time,
+            const std::vector<AlignedBox>&
+            robot_collision_shape_bounding_boxes,
+            const std::vector<T>& tracking_errors,
+            const OccupancyGrid& occupancy_grid,
+            const std::vector<bool>& candidates = std::vector<bool>(),
+            const std::vector<bool>& safety_critical = std::vector<bool>()
+    ) {
+        const std::size_t num_robots = m_last_planning_times.size();
+        if(!candidates.empty()) {
+            this->checkSize(candidates.size(), "candidates");
+        }
+        if(!safety_critical.empty()) {
+            this->checkSize(safety_critical.size(), "safety critical flags");
+        }
+
+        for(std::size_t i = 0; i < num_robots; i++) {
+            if(m_last_planning_times[i]) {
+                m_statistics_storage.addPlanAge(
+                        i, current_time - *m_last_planning_times[i]);
+            }
+        }
+
+        const std::vector<T> robot_urgencies = this->urgencies(
+                current_time,
+                robot_collision_shape_bounding_boxes,
+                tracking_errors,
+                occupancy_grid
+        );
+
+        std::vector<std::size_t> order;
+        for(std::size_t i = 0; i < num_robots; i++) {
+            if(candidates.empty() || candidates[i]) {
+                order.push_back(i);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [&](std::size_t a, std::size_t b) {
+                return robot_urgencies[a] > robot_urgencies[b];
+            }
+        );
+
+        std::vector<bool> result(num_robots, false);
+        T used_budget = 0;
+        bool any_planned = false;
+        for(std::size_t i: order) {
+            if((!safety_critical.empty() && safety_critical[i])
+               || !m_last_planning_times[i]) {
+                result[i] = true;
+                used_budget += m_expected_durations[i];
+                any_planned = true;
+            }
+        }
+
+        for(std::size_t i: order) {
+            if(result[i]) {
+                continue;
+            }
+            if(any_planned
+               && used_budget + m_expected_durations[i] > m_cpu_budget) {
+                continue;
+            }
+            result[i] = true;
+            used_budget += m_expected_durations[i];
+            any_planned = true;
+        }
+
+        return result;
+    }
+
+    /*
+     * Reports that robot planned at current_time for duration seconds,
+     * successfully if success is set.
+     */
+    void planned(std::size_t robot, T current_time, T duration, bool success) {
+        if(success) {
+            m_last_planning_times[robot] = current_time;
+        }
+        m_expected_durations[robot]
+            = m_expected_durations[robot] == 0
+              ? duration
+              : (1 - m_duration_smoothing) * m_expected_durations[robot]
+                + m_duration_smoothing * duration;
+    }
+
+    const StatisticsStorage& statisticsStorage() const {
+        return m_statistics_storage;
+    }
+
+private:
+    T m_cpu_budget;
+    T m_proximity_distance;
+    T m_proximity_weight;
+    T m_age_weight;
+    T m_tracking_error_weight;
+    // weight of the latest duration in the expected duration
+    T m_duration_smoothing = 0.3;
+
+    std::vector<std::optional<T>> m_last_planning_times;
+    std::vector<T> m_expected_durations;
+
+    StatisticsStorage m_statistics_storage;
+
+    void checkSize(std::size_t size, const std::string& name) const {
+        if(size != m_last_planning_times.size()) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "scheduler needs ",
+                    m_last_planning_times.size(),
+                    " ",
+                    name,
+                    ", given: ",
+                    size
+                )
+            );
+        }
+    }
+}; // class ReplanningScheduler
+
+} // namespace rlss
+
+#endif // RLSS_REPLANNING_SCHEDULER_HPP
@@ -0,0 +1,248 @@
+#ifndef RLSS_REPLANNING_TRIGGER_HPP
+#define RLSS_REPLANNING_TRIGGER_HPP
+
+#include <rlss/internal/Util.hpp>
+#include <rlss/internal/BatchEval.hpp>
+#include <rlss/CollisionShapes/CollisionShape.hpp>
+#include <rlss/OccupancyGrid.hpp>
+#include <splx/curve/PiecewiseCurve.hpp>
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace rlss {
+
+// why a robot needs to replan, see ReplanningTrigger::replanningReason
+enum class ReplanningReason {
+    None,
+    NoTrajectory,
+    MaximumAge,
+    TrajectoryDeviation,
+    ObstacleCollision,
+    RobotHyperplaneCrossing,
+    OriginalTrajectoryDeviation
+};
+
+/*
+ * Whether the robot is unsafe if it does not replan for reason. Replans for
+ * the other reasons keep trajectories fresh and on track to the goal, and a
+ * planning budget may postpone them.
+ */
+inline bool isSafetyCritical(ReplanningReason reason) {
+    switch(reason) {
+        case ReplanningReason::NoTrajectory:
+        case ReplanningReason::TrajectoryDeviation:
+        case ReplanningReason::ObstacleCollision:
+        case ReplanningReason::RobotHyperplaneCrossing:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Decides whether a robot needs to replan in event triggered replanning, or
+ * whether it can keep following its current trajectory for another
+ * replanning period. The check is cheap compared to planning: it samples
+ * the rest of the current trajectory instead of solving any optimization
+ * problem.
+ *
+ * Robots that keep their trajectories do not respect the hyperplanes the
+ * replanning robots compute against them. A robot keeps its trajectory
+ * only if it stays within half the distance to each other robot's current
+ * box during the next period, which keeps it on its side of the max
+ * margin hyperplane between the two robots.
+ */
+template<typename T, unsigned int DIM>
+class ReplanningTrigger {
+public:
+    using VectorDIM = internal::VectorDIM<T, DIM>;
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+    using MatrixDIMX = internal::MatrixDIMX<T, DIM>;
+    using OccupancyGrid = rlss::OccupancyGrid<T, DIM>;
+    using CollisionShape = rlss::CollisionShape<T, DIM>;
+    using PiecewiseCurve = splx::PiecewiseCurve<T, DIM>;
+
+    ReplanningTrigger(
+            std::shared_ptr<CollisionShape> collision_shape,
+            const PiecewiseCurve& original_trajectory,
+            T max_deviation,
+            T max_age,
+            T check_step
+    ) : m_collision_shape(collision_shape),
+        m_original_trajectory(original_trajectory),
+        m_max_deviation(max_deviation),
+        m_max_age(max_age),
+        m_check_step(check_step)
+    {
+        if(!(check_step > 0)) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "replanning trigger check step must be positive, given: ",
+                    check_step
+                )
+            );
+        }
+    }
+
+    // time the current trajectory is planned at
+    void setLastPlanningTime(T time) {
+        m_last_planning_time = time;
+    }
+
+    /*
+     * Whether the robot at current_position at current_time needs to
+     * replan instead of following trajectory, which it is at parameter
+     * trajectory_time of, for another replanning_period. See
+     * replanningReason.
+     */
+    bool needsReplanning(
+            T current_time,
+            const VectorDIM& current_position,
+            const PiecewiseCurve& trajectory,
+            T trajectory_time,
+            T replanning_period,
+            const OccupancyGrid& occupancy_grid,
+            const std::vector<AlignedBox>&
+            other_robot_collision_shape_bounding_boxes
+    ) {
+        return this->replanningReason(
+                current_time,
+                current_position,
+                trajectory,
+                trajectory_time,
+                replanning_period,
+                occupancy_grid,
+                other_robot_collision_shape_bounding_boxes
+        ) != ReplanningReason::None;
+    }
+
+    /*
+     * First reason for which the robot needs to replan, checked in order:
+     *  - no trajectory is planned yet,
+     *  - the robot is more than max deviation away from its trajectory,
+     *  - the rest of the trajectory collides with occupancy_grid,
+     *  - the robot may cross the hyperplane to one of the other robots
+     *    during the next period,
+     *  - the trajectory is max age old,
+     *  - the robot is more than max deviation away from its original
+     *    trajectory at the end of the next period.
+     * None if it can keep following trajectory. Safety critical reasons are
+     * checked first, so the result is safety critical whenever one holds.
+     */
+    ReplanningReason replanningReason(
+            T current_time,
+            const VectorDIM& current_position,
+            const PiecewiseCurve& trajectory,
+            T trajectory_time,
+            T replanning_period,
+            const OccupancyGrid& occupancy_grid,
+            const std::vector<AlignedBox>&
+            other_robot_collision_shape_bounding_boxes
+    ) {
+        if(!m_last_planning_time) {
+            debug_message("replanning: no trajectory is planned yet");
+            return ReplanningReason::NoTrajectory;
+        }
+
+        const T max_parameter = trajectory.maxParameter();
+        const T start = std::min(trajectory_time, max_parameter);
+        const T period_end
+                = std::min(trajectory_time + replanning_period, max_parameter);
+
+        if((trajectory.eval(start, 0) - current_position).norm()
+                > m_max_deviation) {
+            debug_message("replanning: robot deviates from its trajectory");
+            return ReplanningReason::TrajectoryDeviation;
+        }
+
+        // samples of the next period end with the end of the period
+        m_params.clear();
+        for(T param = start; param < period_end; param += m_check_step) {
+            m_params.push_back(param);
+        }
+        m_params.push_back(period_end);
+        const std::size_t period_end_index = m_params.size() - 1;
+        for(T param = period_end + m_check_step;
+                param < max_parameter;
+                param += m_check_step) {
+            m_params.push_back(param);
+        }
+        if(period_end < max_parameter) {
+            m_params.push_back(max_parameter);
+        }
+        internal::batchEval<T, DIM>(trajectory, m_params, 0, m_positions);
+
+        const AlignedBox current_box
+                = m_collision_shape->boundingBox(current_position);
+        AlignedBox swept_box = current_box;
+        for(Eigen::Index j = 0; j < m_positions.cols(); j++) {
+            const AlignedBox box
+                    = m_collision_shape->boundingBox(m_positions.col(j));
+            if(occupancy_grid.isOccupied(box)) {
+                debug_message(
+                        "replanning: trajectory collides with an obstacle at ",
+                        m_params[j]);
+                return ReplanningReason::ObstacleCollision;
+            }
+            if(static_cast<std::size_t>(j) <= period_end_index) {
+                swept_box.extend(box);
+            }
+        }
+
+        // every point of swept_box is within this distance to current_box
+        VectorDIM extension = VectorDIM::Zero();
+        for(unsigned int d = 0; d < DIM; d++) {
+            extension(d) = std::max(
+                    swept_box.max()(d) - current_box.max()(d),
+                    current_box.min()(d) - swept_box.min()(d)
+            );
+        }
+        const T sweep_distance = extension.norm();
+        for(const AlignedBox& other_box:
+                other_robot_collision_shape_bounding_boxes) {
+            if(2 * sweep_distance >= current_box.exteriorDistance(other_box)) {
+                debug_message("replanning: robot may cross the hyperplane ",
+                              "to another robot");
+                return ReplanningReason::RobotHyperplaneCrossing;
+            }
+        }
+
+        if(current_time - *m_last_planning_time >= m_max_age) {
+            debug_message("replanning: trajectory reached maximum age");
+            return ReplanningReason::MaximumAge;
+        }
+
+        const VectorDIM original_position = m_original_trajectory.eval(
+                std::min(
+                        current_time + replanning_period,
+                        m_original_trajectory.maxParameter()
+                ),
+                0
+        );
+        if((m_positions.col(period_end_index) - original_position).norm()
+                > m_max_deviation) {
+            debug_message("replanning: robot deviates from its original ",
+                          "trajectory");
+            return ReplanningReason::OriginalTrajectoryDeviation;
+        }
+
+        return ReplanningReason::None;
+    }
+
+private:
+    std::shared_ptr<CollisionShape> m_collision_shape;
+    PiecewiseCurve m_original_trajectory;
+    T m_max_deviation;
+    T m_max_age;
+    T m_check_step;
+    std::optional<T> m_last_planning_time;
+
+    // sample parameters and positions, kept between calls
+    std::vector<T> m_params;
+    MatrixDIMX m_positions;
+}; // class ReplanningTrigger
+
+} // namespace rlss
+
+#endif // RLSS_REPLANNING_TRIGGER_HPP
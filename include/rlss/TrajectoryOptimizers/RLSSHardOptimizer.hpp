@@ -33,16 +33,23 @@ public:
         unsigned int contupto,
         const std::vector<std::pair<unsigned int, T>>& lambdas,
         const std::vector<T>& thetas,
-        T obstacle_check_distance
+        T obstacle_check_distance,
+        ObstacleConstraintGenerator obstacle_constraint_generator
+                = ObstacleConstraintGenerator::SVM,
+        const QPSolverSelection& solvers = QPSolverSelection(),
+        bool warm_start = false
     ): m_collision_shape(colshape),
        m_qp_generator(qpgen),
        m_workspace(ws),
        m_continuity_upto(contupto),
        m_lambda_integrated_squared_derivatives(lambdas),
        m_theta_position_at(thetas),
-       m_obstacle_check_distance(obstacle_check_distance)
+       m_obstacle_check_distance(obstacle_check_distance),
+       m_obstacle_constraint_generator(obstacle_constraint_generator),
+       m_solvers(solvers),
+       m_warm_start(warm_start)
     {
-
+        internal::QPSolverRegistry<T>::instance().validate(m_solvers);
     }
 
 
@@ -54,8 +61,22 @@ public:
             const OccupancyGrid& occupancy_grid,
             const StdVectorVectorDIM& current_robot_state
     )  override {
+        this->m_solver_durations.clear();
+        // releases the temporaries of the previous call at once
+        this->m_planner_workspace.arena().reset();
+
+        m_mathematica.reset();
 
-        internal::MathematicaWriter<T, DIM> mathematica;
+        internal::OptimizationProblemOptions<T, DIM> options;
+        options.obstacle_constraint_generator
+                = m_obstacle_constraint_generator;
+        options.solvers = m_solvers;
+        options.solver_durations = &this->m_solver_durations;
+        options.workspace = &this->m_planner_workspace;
+        options.precomputed_robot_hyperplanes
+                = this->robotSafetyHyperplanes();
+        options.robot_culling_speed = this->m_robot_culling_speed;
+        options.deadline = this->m_deadline;
 
         try {
             internal::generate_optimization_problem<T, DIM>(
@@ -71,34 +92,80 @@ public:
                     oth_rbt_col_shape_bboxes,
                     occupancy_grid,
                     current_robot_state,
-                    mathematica
+                    m_mathematica,
+                    options
             );
         } catch(...) {
             return std::nullopt;
         }
 
 
-        QPWrappers::RLSS_HARD_QP_SOLVER::Engine<T> solver;
-        solver.setFeasibilityTolerance(1e-9);
+        std::shared_ptr<internal::QPSolver<T>> solver
+                = this->m_planner_workspace.solver(
+                        m_solvers.hard,
+                        internal::PlannerWorkspace<T>::TrajectorySlot);
+        solver->setFeasibilityTolerance(1e-9);
         auto initial_guess = m_qp_generator.getDVarsForSegments(segments);
+        bool warm_started = false;
+        if(m_warm_start && this->m_previous_plan) {
+            std::optional<Vector> warm_guess
+                = internal::warmStartDecisionVariables<T, DIM>(
+                        m_qp_generator,
+                        initial_guess,
+                        this->m_previous_plan->second,
+                        this->m_planning_time - this->m_previous_plan->first
+                  );
+            if(warm_guess) {
+                initial_guess = *warm_guess;
+                warm_started = true;
+            }
+        }
+
+        // the solve gets what is left until the deadline
+        if(this->m_deadline.expired()) {
+            return std::nullopt;
+        }
+        solver->setTimeLimit(this->m_deadline.template remainingSeconds<T>());
         Vector soln;
         QPWrappers::OptReturnType ret = QPWrappers::OptReturnType::Unknown;
         try {
-            ret = solver.next(
+            ret = solver->next(
                     m_qp_generator.getProblem(), soln, initial_guess);
         } catch (...) {
         }
+        this->m_solver_durations.emplace_back(
+                warm_started
+                    ? absl::StrCat(solver->name(), "_warm_start")
+                    : solver->name(),
+                solver->lastSolveDuration());
 
         debug_message("optimization return value: ", ret);
 
         if(ret == QPWrappers::OptReturnType::Optimal) {
             auto result = m_qp_generator.extractCurve(soln);
-            mathematica.piecewiseCurve(result);
+            m_mathematica.piecewiseCurve(result);
             return result;
         } else {
             return std::nullopt;
         }
     }
+
+    std::shared_ptr<Base> clone() const override {
+        auto result = std::make_shared<RLSSHardOptimizer>(
+                m_collision_shape,
+                m_qp_generator,
+                m_workspace,
+                m_continuity_upto,
+                m_lambda_integrated_squared_derivatives,
+                m_theta_position_at,
+                m_obstacle_check_distance,
+                m_obstacle_constraint_generator,
+                m_solvers,
+                m_warm_start
+        );
+        this->copyStateTo(*result);
+        return result;
+    }
 private:
     std::shared_ptr<CollisionShape> m_collision_shape;
     PiecewiseCurveQPGenerator m_qp_generator;
@@ -108,6 +175,11 @@ private:
         m_lambda_integrated_squared_derivatives;
     std::vector<T> m_theta_position_at;
     T m_obstacle_check_distance;
+    ObstacleConstraintGenerator m_obstacle_constraint_generator;
+    QPSolverSelection m_solvers;
+    bool m_warm_start;
+    // kept across calls and reset at the start of each call
+    internal::MathematicaWriter<T, DIM> m_mathematica;
 }; // class TrajectoryOptimizer
 
 }
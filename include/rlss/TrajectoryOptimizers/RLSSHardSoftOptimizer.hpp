@@ -8,6 +8,8 @@
 #include <rlss/internal/SVM.hpp>
 #include <rlss/internal/MathematicaWriter.hpp>
 #include <chrono>
+#include <future>
+#include <rlss/internal/RLSSOptimization.hpp>
 
 namespace rlss {
 
@@ -24,6 +26,9 @@ namespace rlss {
         using CollisionShape = rlss::CollisionShape<T, DIM>;
         using Hyperplane = rlss::internal::Hyperplane<T, DIM>;
         using Vector = typename PiecewiseCurveQPGenerator::Vector;
+        using Problem = QPWrappers::Problem<T>;
+        using QPSolver = internal::QPSolver<T>;
+        using SolveResult = std::pair<QPWrappers::OptReturnType, Vector>;
 
         RLSSHardSoftOptimizer(
             std::shared_ptr<CollisionShape> colshape,
@@ -34,7 +39,12 @@ namespace rlss {
             const std::vector<T>& thetas,
             const std::unordered_map<std::string, std::pair<bool, T>>&
                     soft_parameters,
-            T obstacle_check_distance
+            T obstacle_check_distance,
+            ObstacleConstraintGenerator obstacle_constraint_generator
+                    = ObstacleConstraintGenerator::SVM,
+            const QPSolverSelection& solvers = QPSolverSelection(),
+            bool concurrent_soft_solve = false,
+            bool warm_start = false
         ): m_collision_shape(colshape),
            m_qp_generator(qpgen),
            m_workspace(ws),
@@ -42,9 +52,13 @@ namespace rlss {
            m_lambda_integrated_squared_derivatives(lambdas),
            m_theta_position_at(thetas),
            m_soft_parameters(soft_parameters),
-           m_obstacle_check_distance(obstacle_check_distance)
+           m_obstacle_check_distance(obstacle_check_distance),
+           m_obstacle_constraint_generator(obstacle_constraint_generator),
+           m_solvers(solvers),
+           m_concurrent_soft_solve(concurrent_soft_solve),
+           m_warm_start(warm_start)
         {
-
+            internal::QPSolverRegistry<T>::instance().validate(m_solvers);
         }
 
 
@@ -56,8 +70,23 @@ namespace rlss {
                 const OccupancyGrid& occupancy_grid,
                 const StdVectorVectorDIM& current_robot_state
         )  override {
+            this->m_solver_durations.clear();
+            // releases the temporaries of the previous call at once
+            this->m_planner_workspace.arena().reset();
+
+            m_mathematica.reset();
 
-            internal::MathematicaWriter<T, DIM> mathematica;
+            internal::OptimizationProblemOptions<T, DIM> options;
+            options.soft_parameters = &m_soft_parameters;
+            options.obstacle_constraint_generator
+                = m_obstacle_constraint_generator;
+            options.solvers = m_solvers;
+            options.solver_durations = &this->m_solver_durations;
+            options.workspace = &this->m_planner_workspace;
+            options.precomputed_robot_hyperplanes
+                    = this->robotSafetyHyperplanes();
+            options.robot_culling_speed = this->m_robot_culling_speed;
+            options.deadline = this->m_deadline;
 
             try {
                 internal::generate_optimization_problem<T, DIM>(
@@ -73,56 +102,159 @@ namespace rlss {
                         oth_rbt_col_shape_bboxes,
                         occupancy_grid,
                         current_robot_state,
-                        mathematica,
-                        m_soft_parameters
+                        m_mathematica,
+                        options
                 );
             } catch(...) {
                 return std::nullopt;
             }
 
 
-            QPWrappers::RLSS_HARD_QP_SOLVER::Engine<T> solver;
-            solver.setFeasibilityTolerance(1e-9);
             auto initial_guess = m_qp_generator.getDVarsForSegments(segments);
+            bool warm_started = false;
+            if(m_warm_start && this->m_previous_plan) {
+                std::optional<Vector> warm_guess
+                    = internal::warmStartDecisionVariables<T, DIM>(
+                            m_qp_generator,
+                            initial_guess,
+                            this->m_previous_plan->second,
+                            this->m_planning_time - this->m_previous_plan->first
+                      );
+                if(warm_guess) {
+                    initial_guess = *warm_guess;
+                    warm_started = true;
+                }
+            }
+
+            // in concurrent mode, the soft problem is solved on another
+            // thread while the hard problem is solved on this one, unless
+            // the soft solve of a previous call that lost the race is still
+            // running. so at most one abandoned soft solve runs at a time.
+            // it uses workspace slot SoftSlot, so the soft solver is in slot
+            // SoftSlot + 1 while it runs and in slot SoftSlot otherwise.
+            using PlannerWorkspace = internal::PlannerWorkspace<T>;
+            const bool abandoned_running
+                    = this->abandonedSoftSolveRunning();
+            const bool race = m_concurrent_soft_solve && !abandoned_running;
+            const std::size_t soft_solver_slot
+                    = abandoned_running ? PlannerWorkspace::SoftSlot + 1
+                                        : PlannerWorkspace::SoftSlot;
+            std::shared_ptr<QPSolver> soft_solver
+                    = this->m_planner_workspace.solver(
+                            m_solvers.soft, soft_solver_slot);
+            std::shared_ptr<QPSolver> solver
+                    = this->m_planner_workspace.solver(
+                            m_solvers.hard, PlannerWorkspace::TrajectorySlot);
+
+            // both solves get what is left until the deadline
+            if(this->m_deadline.expired()) {
+                return std::nullopt;
+            }
+            const T remaining_seconds
+                    = this->m_deadline.template remainingSeconds<T>();
+            solver->setTimeLimit(remaining_seconds);
+            soft_solver->setTimeLimit(remaining_seconds);
+
+            std::future<SolveResult> soft_solve;
+            if(race) {
+                // the copy of the problem is in the workspace slot of the
+                // soft solver, which no other running solve uses
+                const Problem& soft_problem
+                        = this->m_planner_workspace.problemCopy(
+                                m_qp_generator.getProblem(),
+                                soft_solver_slot);
+                soft_solve = std::async(
+                        std::launch::async,
+                        [soft_solver, &soft_problem, initial_guess]() {
+                            return solveSoft(
+                                    *soft_solver, soft_problem, initial_guess);
+                        }
+                );
+            }
+
+            solver->setFeasibilityTolerance(1e-9);
             Vector soln;
             QPWrappers::OptReturnType ret = QPWrappers::OptReturnType::Unknown;
 
             try {
-                ret = solver.next(
+                ret = solver->next(
                         m_qp_generator.getProblem(), soln, initial_guess);
             } catch (...) {
             }
+            this->m_solver_durations.emplace_back(
+                    warm_started
+                        ? absl::StrCat(solver->name(), "_warm_start")
+                        : solver->name(),
+                    solver->lastSolveDuration());
             debug_message("hard optimization return value: ", ret);
 
             if(ret == QPWrappers::OptReturnType::Optimal) {
+                if(soft_solve.valid()) {
+                    // the soft solve lost the race. it is stopped if its
+                    // backend supports it and left running otherwise. no
+                    // soft solve is raced until it returns.
+                    if(soft_solver->supportsStop()) {
+                        soft_solver->requestStop();
+                    }
+                    m_abandoned_soft_solve = std::move(soft_solve);
+                }
                 auto result = m_qp_generator.extractCurve(soln);
-                mathematica.piecewiseCurve(result);
+                m_mathematica.piecewiseCurve(result);
                 return result;
             } else {
-                auto soft_problem = m_qp_generator.getProblem().convert_to_soft();
-                Vector soft_initial_guess(soft_problem.num_vars());
-                soft_initial_guess.setZero();
-                soft_initial_guess.block(0, 0, initial_guess.rows(), 1) = initial_guess;
-                Vector soft_solution;
-                QPWrappers::RLSS_SOFT_QP_SOLVER::Engine<T> solver;
-                solver.setFeasibilityTolerance(1e-9);
-                try {
-                    ret = solver.next(soft_problem, soft_solution,
-                                      soft_initial_guess);
-                } catch(...) {
+                if(!soft_solve.valid()) {
+                    if(this->m_deadline.expired()) {
+                        return std::nullopt;
+                    }
+                    soft_solver->setTimeLimit(
+                        this->m_deadline.template remainingSeconds<T>());
                 }
+                SolveResult soft_result
+                    = soft_solve.valid()
+                      ? soft_solve.get()
+                      : solveSoft(
+                            *soft_solver,
+                            m_qp_generator.getProblem(),
+                            initial_guess
+                        );
+                ret = soft_result.first;
+                const Vector& soft_solution = soft_result.second;
+                this->m_solver_durations.emplace_back(
+                        warm_started
+                            ? absl::StrCat(soft_solver->name(), "_warm_start")
+                            : soft_solver->name(),
+                        soft_solver->lastSolveDuration());
                 debug_message("soft optimization return value: ", ret);
                 if(ret == QPWrappers::OptReturnType::Optimal) {
                     Vector soft_solution_primary
                         = soft_solution.block(0, 0, initial_guess.rows(), 1);
                     auto result = m_qp_generator.extractCurve(soft_solution_primary);
-                    mathematica.piecewiseCurve(result);
+                    m_mathematica.piecewiseCurve(result);
                     return result;
                 } else {
                     return std::nullopt;
                 }
             }
         }
+
+        std::shared_ptr<Base> clone() const override {
+            auto result = std::make_shared<RLSSHardSoftOptimizer>(
+                    m_collision_shape,
+                    m_qp_generator,
+                    m_workspace,
+                    m_continuity_upto,
+                    m_lambda_integrated_squared_derivatives,
+                    m_theta_position_at,
+                    m_soft_parameters,
+                    m_obstacle_check_distance,
+                    m_obstacle_constraint_generator,
+                    m_solvers,
+                    m_concurrent_soft_solve,
+                    m_warm_start
+            );
+            this->copyStateTo(*result);
+            return result;
+        }
     private:
         std::shared_ptr<CollisionShape> m_collision_shape;
         PiecewiseCurveQPGenerator m_qp_generator;
@@ -133,6 +265,50 @@ namespace rlss {
         std::vector<T> m_theta_position_at;
         std::unordered_map<std::string, std::pair<bool, T>> m_soft_parameters;
         T m_obstacle_check_distance;
+        ObstacleConstraintGenerator m_obstacle_constraint_generator;
+        QPSolverSelection m_solvers;
+        bool m_concurrent_soft_solve;
+        bool m_warm_start;
+        // kept across calls and reset at the start of each call
+        internal::MathematicaWriter<T, DIM> m_mathematica;
+
+        // soft solve of a previous call that lost the race, using
+        // workspace slot SoftSlot. destroying the optimizer waits for it if
+        // it is still running.
+        std::future<SolveResult> m_abandoned_soft_solve;
+
+        // whether the abandoned soft solve is still running. releases it
+        // once it returned.
+        bool abandonedSoftSolveRunning() {
+            if(m_abandoned_soft_solve.valid()
+               && m_abandoned_soft_solve.wait_for(std::chrono::seconds(0))
+                  == std::future_status::ready) {
+                m_abandoned_soft_solve = std::future<SolveResult>();
+            }
+            return m_abandoned_soft_solve.valid();
+        }
+
+        // solves the soft version of the hard problem starting from the
+        // initial guess of the hard problem
+        static SolveResult solveSoft(
+                QPSolver& solver,
+                const Problem& problem,
+                const Vector& initial_guess
+        ) {
+            auto soft_problem = problem.convert_to_soft();
+            Vector soft_initial_guess(soft_problem.num_vars());
+            soft_initial_guess.setZero();
+            soft_initial_guess.block(0, 0, initial_guess.rows(), 1) = initial_guess;
+
+            SolveResult result(QPWrappers::OptReturnType::Unknown, Vector());
+            solver.setFeasibilityTolerance(1e-9);
+            try {
+                result.first = solver.next(
+                        soft_problem, result.second, soft_initial_guess);
+            } catch(...) {
+            }
+            return result;
+        }
     }; // class TrajectoryOptimizer
 
 }
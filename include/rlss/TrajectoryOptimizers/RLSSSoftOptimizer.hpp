@@ -3,6 +3,7 @@
 
 #include <rlss/TrajectoryOptimizers/TrajectoryOptimizer.hpp>
 #include <rlss/internal/Util.hpp>
+#include <rlss/internal/RLSSOptimization.hpp>
 
 namespace rlss {
 
@@ -29,7 +30,11 @@ public:
         const std::vector<T>& thetas,
         const std::unordered_map<std::string, std::pair<bool, T>>&
                     soft_parameters,
-        T obstacle_check_distance
+        T obstacle_check_distance,
+        ObstacleConstraintGenerator obstacle_constraint_generator
+                = ObstacleConstraintGenerator::SVM,
+        const QPSolverSelection& solvers = QPSolverSelection(),
+        bool warm_start = false
         ): m_collision_shape(colshape),
         m_qp_generator(qpgen),
         m_workspace(ws),
@@ -37,9 +42,12 @@ public:
         m_lambda_integrated_squared_derivatives(lambdas),
         m_theta_position_at(thetas),
         m_soft_parameters(soft_parameters),
-        m_obstacle_check_distance(obstacle_check_distance)
+        m_obstacle_check_distance(obstacle_check_distance),
+        m_obstacle_constraint_generator(obstacle_constraint_generator),
+        m_solvers(solvers),
+        m_warm_start(warm_start)
     {
-
+        internal::QPSolverRegistry<T>::instance().validate(m_solvers);
     }
 
     // returns std::nullopt when optimization fails
@@ -50,7 +58,22 @@ public:
             const OccupancyGrid& occupancy_grid,
             const StdVectorVectorDIM& current_robot_state
     )  override {
-        internal::MathematicaWriter<T, DIM> mathematica;
+        this->m_solver_durations.clear();
+        // releases the temporaries of the previous call at once
+        this->m_planner_workspace.arena().reset();
+        m_mathematica.reset();
+
+        internal::OptimizationProblemOptions<T, DIM> options;
+        options.soft_parameters = &m_soft_parameters;
+        options.obstacle_constraint_generator
+                = m_obstacle_constraint_generator;
+        options.solvers = m_solvers;
+        options.solver_durations = &this->m_solver_durations;
+        options.workspace = &this->m_planner_workspace;
+        options.precomputed_robot_hyperplanes
+                = this->robotSafetyHyperplanes();
+        options.robot_culling_speed = this->m_robot_culling_speed;
+        options.deadline = this->m_deadline;
 
         try {
             internal::generate_optimization_problem<T, DIM>(
@@ -66,8 +89,8 @@ public:
                     oth_rbt_col_shape_bboxes,
                     occupancy_grid,
                     current_robot_state,
-                    mathematica,
-                    m_soft_parameters
+                    m_mathematica,
+                    options
             );
         } catch(...) {
             return std::nullopt;
@@ -75,6 +98,20 @@ public:
 
 
         auto initial_guess = m_qp_generator.getDVarsForSegments(segments);
+        bool warm_started = false;
+        if(m_warm_start && this->m_previous_plan) {
+            std::optional<Vector> warm_guess
+                = internal::warmStartDecisionVariables<T, DIM>(
+                        m_qp_generator,
+                        initial_guess,
+                        this->m_previous_plan->second,
+                        this->m_planning_time - this->m_previous_plan->first
+                  );
+            if(warm_guess) {
+                initial_guess = *warm_guess;
+                warm_started = true;
+            }
+        }
         auto problem = m_qp_generator.getProblem()
                             .convert_to_soft();
         debug_message("hard num vars: "
@@ -83,18 +120,32 @@ public:
                     , problem.num_vars());
         auto soft_initial_guess = Vector(problem.num_vars());
         soft_initial_guess.setZero();
-        soft_initial_guess.block(0, 0, initial_guess.cols(), 1) = initial_guess;
+        soft_initial_guess.block(0, 0, initial_guess.rows(), 1) = initial_guess;
+
 
+        std::shared_ptr<internal::QPSolver<T>> solver
+                = this->m_planner_workspace.solver(
+                        m_solvers.soft,
+                        internal::PlannerWorkspace<T>::TrajectorySlot);
+        solver->setFeasibilityTolerance(1e-9);
 
-        QPWrappers::RLSS_SOFT_QP_SOLVER::Engine<T> solver;
-        solver.setFeasibilityTolerance(1e-9);
+        // the solve gets what is left until the deadline
+        if(this->m_deadline.expired()) {
+            return std::nullopt;
+        }
+        solver->setTimeLimit(this->m_deadline.template remainingSeconds<T>());
         Vector soln;
         QPWrappers::OptReturnType ret = QPWrappers::OptReturnType::Unknown;
         try {
-            ret = solver.next(
+            ret = solver->next(
                     problem, soln, soft_initial_guess);
         } catch(...) {
         }
+        this->m_solver_durations.emplace_back(
+                warm_started
+                    ? absl::StrCat(solver->name(), "_warm_start")
+                    : solver->name(),
+                solver->lastSolveDuration());
         debug_message("optimization return value: ", ret);
         if(ret == QPWrappers::OptReturnType::Optimal) {
             debug_message("slack variables: ",
@@ -107,12 +158,30 @@ public:
                 = soln.block(0, 0, m_qp_generator.numDecisionVariables(), 1);
             debug_message("primary variables: ", soln_primary. transpose());
             auto result = m_qp_generator.extractCurve(soln_primary);
-            mathematica.piecewiseCurve(result);
+            m_mathematica.piecewiseCurve(result);
             return result;
         } else {
             return std::nullopt;
         }
     }
+
+    std::shared_ptr<Base> clone() const override {
+        auto result = std::make_shared<RLSSSoftOptimizer>(
+                m_collision_shape,
+                m_qp_generator,
+                m_workspace,
+                m_continuity_upto,
+                m_lambda_integrated_squared_derivatives,
+                m_theta_position_at,
+                m_soft_parameters,
+                m_obstacle_check_distance,
+                m_obstacle_constraint_generator,
+                m_solvers,
+                m_warm_start
+        );
+        this->copyStateTo(*result);
+        return result;
+    }
 private:
     std::shared_ptr<CollisionShape> m_collision_shape;
     PiecewiseCurveQPGenerator m_qp_generator;
@@ -123,6 +192,11 @@ private:
     std::vector<T> m_theta_position_at;
     std::unordered_map<std::string, std::pair<bool, T>> m_soft_parameters;
     T m_obstacle_check_distance;
+    ObstacleConstraintGenerator m_obstacle_constraint_generator;
+    QPSolverSelection m_solvers;
+    bool m_warm_start;
+    // kept across calls and reset at the start of each call
+    internal::MathematicaWriter<T, DIM> m_mathematica;
 
 }; // RLSSSoftOptimizer
 
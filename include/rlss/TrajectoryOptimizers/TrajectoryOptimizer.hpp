@@ -2,7 +2,14 @@
 #define RLSS_TRAJECTORY_OPTIMIZER_HPP
 
 #include <rlss/internal/Util.hpp>
+#include <rlss/internal/QPSolver.hpp>
+#include <rlss/internal/PlannerWorkspace.hpp>
+#include <rlss/internal/Deadline.hpp>
+#include <rlss/OccupancyGrid.hpp>
 #include <splx/curve/PiecewiseCurve.hpp>
+#include <limits>
+#include <memory>
+#include <optional>
 
 namespace rlss {
 
@@ -13,6 +20,7 @@ public:
     using AlignedBox = rlss::internal::AlignedBox<T, DIM>;
     using OccupancyGrid = rlss::OccupancyGrid<T, DIM>;
     using PiecewiseCurve = splx::PiecewiseCurve<T, DIM>;
+    using Hyperplane = rlss::internal::Hyperplane<T, DIM>;
 
     virtual ~TrajectoryOptimizer() {
 
@@ -27,6 +35,94 @@ public:
         const StdVectorVectorDIM& current_robot_state
     ) = 0;
 
+    // returns an optimizer with the same parameters and state that can be
+    // used concurrently with this one, or nullptr if cloning is not
+    // supported
+    virtual std::shared_ptr<TrajectoryOptimizer> clone() const {
+        return nullptr;
+    }
+
+    // durations of the solver calls made during the last call to optimize
+    const internal::SolverDurations<T>& solverDurations() const {
+        return m_solver_durations;
+    }
+
+    // time at which the curves of the following optimize calls start
+    void setPlanningTime(T time) {
+        m_planning_time = time;
+    }
+
+    // curve that starts at start_time and is currently followed. optimizers
+    // may warm start from it. the curve is copied into the previous one so
+    // that its storage is reused.
+    void setPreviousPlan(T start_time, const PiecewiseCurve& curve) {
+        if(m_previous_plan) {
+            m_previous_plan->first = start_time;
+            m_previous_plan->second = curve;
+        } else {
+            m_previous_plan.emplace(start_time, curve);
+        }
+    }
+
+    // robot to robot safety hyperplanes of the following optimize calls,
+    // one for each other robot in the order of the other robot bounding
+    // boxes. optimizers compute the missing ones from the bounding boxes.
+    void setRobotSafetyHyperplanes(
+            const std::vector<std::optional<Hyperplane>>& hyperplanes) {
+        m_robot_safety_hyperplanes = hyperplanes;
+    }
+
+    void clearRobotSafetyHyperplanes() {
+        m_robot_safety_hyperplanes = std::nullopt;
+    }
+
+    // other robots farther than speed times the duration of the first piece
+    // to the robot get no robot to robot safety hyperplanes. speed is the
+    // sum of the maximum speeds of two robots, so that culled robots can
+    // not reach each other during the first piece.
+    void setRobotCullingSpeed(T speed) {
+        m_robot_culling_speed = speed;
+    }
+
+    // deadline of the following optimize calls. optimizers limit the time
+    // of their solvers to it and return std::nullopt once it expires.
+    void setDeadline(const internal::Deadline& deadline) {
+        m_deadline = deadline;
+    }
+
+protected:
+    internal::SolverDurations<T> m_solver_durations;
+    T m_planning_time = 0;
+    std::optional<std::pair<T, PiecewiseCurve>> m_previous_plan;
+
+    std::optional<std::vector<std::optional<Hyperplane>>>
+            m_robot_safety_hyperplanes;
+    // no culling by default
+    T m_robot_culling_speed = std::numeric_limits<T>::infinity();
+    internal::Deadline m_deadline;
+
+    // solvers reused across optimize calls
+    internal::PlannerWorkspace<T> m_planner_workspace;
+
+    // copies the state set through the setters, i.e. planning time,
+    // previous plan, robot safety hyperplanes, robot culling speed and
+    // deadline, to other. used by clone so that clones plan like this
+    // optimizer does.
+    void copyStateTo(TrajectoryOptimizer& other) const {
+        other.m_planning_time = m_planning_time;
+        other.m_previous_plan = m_previous_plan;
+        other.m_robot_safety_hyperplanes = m_robot_safety_hyperplanes;
+        other.m_robot_culling_speed = m_robot_culling_speed;
+        other.m_deadline = m_deadline;
+    }
+
+    // nullptr if robot safety hyperplanes are not set
+    const std::vector<std::optional<Hyperplane>>*
+    robotSafetyHyperplanes() const {
+        return m_robot_safety_hyperplanes ? &*m_robot_safety_hyperplanes
+                                          : nullptr;
+    }
+
 }; // class TrajectoryOptimizer
 
 } // namespace rlss
@@ -3,6 +3,7 @@
 
 #include <rlss/internal/Util.hpp>
 #include <rlss/ValidityCheckers/ValidityChecker.hpp>
+#include <rlss/internal/BatchEval.hpp>
 
 namespace rlss {
 template<typename T, unsigned int DIM>
@@ -21,20 +22,26 @@ public:
     }
 
     bool isValid(const PiecewiseCurve &curve) override {
+        m_params.clear();
+        for(
+            T param = 0;
+            param < curve.maxParameter();
+            param += m_search_step
+        ) {
+            m_params.push_back(param);
+        }
+
         for(const auto& [d, l]: m_max_derivative_magnitudes) {
-            for(
-                T param = 0;
-                param < curve.maxParameter();
-                param += m_search_step
-            ) {
-                T norm = curve.eval(param, d).norm();
+            internal::batchEval<T, DIM>(curve, m_params, d, m_values);
+            for(Eigen::Index j = 0; j < m_values.cols(); j++) {
+                T norm = m_values.col(j).norm();
                 if(norm > l) {
                     debug_message(
                             internal::debug::colors::RED,
                             "norm of the ",
                             d,
                             "th degree of curve's derivative at ",
-                            param,
+                            m_params[j],
                             " is ",
                             norm,
                             " while the maximum allowed is ",
@@ -48,10 +55,21 @@ public:
         return true;
     }
 
+    std::shared_ptr<Base> clone() const override {
+        return std::make_shared<RLSSValidityChecker>(
+                m_max_derivative_magnitudes,
+                m_search_step
+        );
+    }
 
 private:
     std::vector<std::pair<unsigned int, T>> m_max_derivative_magnitudes;
     T m_search_step;
+
+    // sample parameters and evaluated derivatives, kept between calls
+    // to avoid reallocating them for each validity check
+    std::vector<T> m_params;
+    internal::MatrixDIMX<T, DIM> m_values;
 };
 } // namespace rlss
 #endif // RLSS_RLSS_VALIDITY_CHECKER_HPP
\ No newline at end of file
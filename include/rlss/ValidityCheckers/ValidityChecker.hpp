@@ -2,6 +2,7 @@
 #define RLSS_VALIDITY_CHECKER_HPP
 
 #include <splx/curve/PiecewiseCurve.hpp>
+#include <memory>
 
 namespace rlss {
 
@@ -15,6 +16,12 @@ public:
     }
 
     virtual bool isValid(const PiecewiseCurve &curve) = 0;
+
+    // returns a validity checker with the same parameters that can be used
+    // concurrently with this one, or nullptr if cloning is not supported
+    virtual std::shared_ptr<ValidityChecker> clone() const {
+        return nullptr;
+    }
 }; // class ValidityChecker
 
 } // namespace rlss
@@ -3,86 +3,164 @@
 
 #include <rlss/OccupancyGrid.hpp>
 #include <rlss/CollisionShapes/CollisionShape.hpp>
+#include <rlss/internal/DenseOccupancyGrid.hpp>
+#include <rlss/internal/ThreadPool.hpp>
+#include <algorithm>
 #include <memory>
-#include <iostream>
+#include <vector>
 
 namespace rlss {
 namespace internal {
 
-// returns all occupancy grid indexes reachable from the start_position without
-// a collision using discrete segments
+// returns the bitmap of all occupancy grid indexes reachable from the
+// start_position without a collision using discrete segments. the bitmap
+// covers the indexes of the workspace.
+//
+// the search is level synchronous: if thread_pool is given, the frontier of
+// each level is split across the threads of the pool that check the
+// segments to the neighbors of their part of the frontier against a dense
+// snapshot of the grid, then the new cells are marked visited and form the
+// next frontier in a sequential, deterministic merge. levels with small
+// frontiers, and all levels without a pool, are expanded on the calling
+// thread. the pool must not be the one the caller runs in.
 template<typename T, unsigned int DIM>
-typename OccupancyGrid<T, DIM>::UnorderedIndexSet BFS(
+IndexBitmap<T, DIM> BFSBitmap(
     const VectorDIM<T, DIM>& start_position,
     const OccupancyGrid<T, DIM>& occupancy_grid,
     const AlignedBox<T, DIM>& workspace,
-    std::shared_ptr<CollisionShape<T, DIM>> collision_shape
+    std::shared_ptr<CollisionShape<T, DIM>> collision_shape,
+    ThreadPool* thread_pool = nullptr
 ) {
-    using VectorDIM = VectorDIM<T, DIM>;
     using AlignedBox = AlignedBox<T, DIM>;
     using OccupancyGrid = OccupancyGrid<T, DIM>;
-    using Coordinate = typename OccupancyGrid::Coordinate;
     using Index = typename OccupancyGrid::Index;
-    using UnorderedIndexSet = typename OccupancyGrid::UnorderedIndexSet;
+    using DenseOccupancyGrid = DenseOccupancyGrid<T, DIM>;
+    using IndexBitmap = IndexBitmap<T, DIM>;
+
+    // minimum number of frontier cells per thread for a level to be split
+    constexpr std::size_t min_cells_per_thread = 256;
+
+    const DenseOccupancyGrid dense_grid(occupancy_grid, workspace);
+    IndexBitmap reachable(dense_grid);
+
+    auto segment_valid = [&](const AlignedBox& from_box, const Index& to) {
+        AlignedBox box = collision_shape->boundingBox(
+                occupancy_grid.getCenter(to));
+        box.extend(from_box);
+        return workspace.contains(box)
+            && !dense_grid.isOccupied(
+                    occupancy_grid.getIndex(box.min()),
+                    occupancy_grid.getIndex(box.max()))
+            && !occupancy_grid.isOccupiedByTemporaryObstacles(box);
+    };
+
+    std::vector<std::size_t> frontier;
 
     Index start_idx = occupancy_grid.getIndex(start_position);
     AlignedBox start_box = collision_shape->boundingBox(start_position);
+    std::vector<Index> start_indexes = occupancy_grid.getNeighbors(start_idx);
+    start_indexes.insert(start_indexes.begin(), start_idx);
+    for(const Index& idx: start_indexes) {
+        if(segment_valid(start_box, idx)) {
+            std::size_t lin = dense_grid.linearIndex(idx);
+            if(reachable.set(lin)) {
+                frontier.push_back(lin);
+            }
+        }
+    }
 
-    UnorderedIndexSet reachable;
-    std::queue<Index> q;
+    // appends the linear indexes of the unvisited neighbors of
+    // frontier[begin, end) that can be moved to, to next. only reads the
+    // visited bitmap.
+    auto expand = [&](
+            std::size_t begin,
+            std::size_t end,
+            std::vector<std::size_t>& next
+    ) {
+        for(std::size_t f = begin; f < end; f++) {
+            const std::size_t lin = frontier[f];
+            const Index idx = dense_grid.index(lin);
+            const AlignedBox from_box = collision_shape->boundingBox(
+                    occupancy_grid.getCenter(idx));
 
-    if(rlss::internal::segmentValid<T, DIM>(
-            occupancy_grid,
-            workspace,
-            start_box,
-            start_idx,
-            collision_shape))
-    {
-        q.push(start_idx);
-        reachable.insert(start_idx);
-    }
+            for(unsigned int d = 0; d < DIM; d++) {
+                for(int dir = -1; dir <= 1; dir += 2) {
+                    Index neigh_idx = idx;
+                    neigh_idx(d) += dir;
+                    if(!dense_grid.contains(neigh_idx)) {
+                        continue;
+                    }
 
-    std::vector<Index> start_neighbors = occupancy_grid.getNeighbors(start_idx);
-    for(const auto& neigh_idx : start_neighbors) {
-        if(rlss::internal::segmentValid<T, DIM>(
-                occupancy_grid,
-                workspace,
-                start_box,
-                neigh_idx,
-                collision_shape))
-        {
-            q.push(neigh_idx);
-            reachable.insert(neigh_idx);
+                    std::size_t neigh_lin = lin + dir * dense_grid.stride(d);
+                    if(!reachable.test(neigh_lin)
+                       && segment_valid(from_box, neigh_idx)) {
+                        next.push_back(neigh_lin);
+                    }
+                }
+            }
         }
-    }
+    };
+
+    const std::size_t num_threads
+            = thread_pool == nullptr ? 1 : thread_pool->threadCount();
+    std::vector<std::vector<std::size_t>> next_parts(num_threads);
+
+    while(!frontier.empty()) {
+        const std::size_t part_count = std::min<std::size_t>(
+                num_threads,
+                std::max<std::size_t>(
+                        1, frontier.size() / min_cells_per_thread));
+        const std::size_t part_size
+                = (frontier.size() + part_count - 1) / part_count;
 
-    while(!q.empty()) {
-        Index& fr = q.front();
-        std::vector<Index> neighbors = occupancy_grid.getNeighbors(fr);
-        AlignedBox fr_box = collision_shape->boundingBox(
-                occupancy_grid.getCenter(fr)
-        );
-        for(const auto& neigh_idx : neighbors) {
-            if(reachable.find(neigh_idx) == reachable.end()
-                && rlss::internal::segmentValid<T, DIM>(
-                    occupancy_grid,
-                    workspace,
-                    fr_box,
-                    neigh_idx,
-                    collision_shape))
-            {
-                q.push(neigh_idx);
-                reachable.insert(neigh_idx);
+        for(std::size_t p = 0; p < part_count; p++) {
+            next_parts[p].clear();
+        }
+
+        auto expand_part = [&](std::size_t p) {
+            expand(
+                std::min(p * part_size, frontier.size()),
+                std::min((p + 1) * part_size, frontier.size()),
+                next_parts[p]
+            );
+        };
+        if(part_count == 1) {
+            expand_part(0);
+        } else {
+            thread_pool->parallelFor(part_count, expand_part);
+        }
+
+        frontier.clear();
+        for(std::size_t p = 0; p < part_count; p++) {
+            for(std::size_t lin: next_parts[p]) {
+                if(reachable.set(lin)) {
+                    frontier.push_back(lin);
+                }
             }
         }
-        q.pop();
     }
 
-
     return reachable;
 }
 
+// returns all occupancy grid indexes reachable from the start_position without
+// a collision using discrete segments
+template<typename T, unsigned int DIM>
+typename OccupancyGrid<T, DIM>::UnorderedIndexSet BFS(
+    const VectorDIM<T, DIM>& start_position,
+    const OccupancyGrid<T, DIM>& occupancy_grid,
+    const AlignedBox<T, DIM>& workspace,
+    std::shared_ptr<CollisionShape<T, DIM>> collision_shape
+) {
+    return BFSBitmap<T, DIM>(
+            start_position,
+            occupancy_grid,
+            workspace,
+            collision_shape
+    ).toIndexSet();
+}
+
 } // namespace internal
 } // namespace rlss
 
-#endif // RLSS_INTERNAL_BFS_HPP
\ No newline at end of file
+#endif // RLSS_INTERNAL_BFS_HPP
@@ -0,0 +1,198 @@
+#ifndef RLSS_INTERNAL_BATCH_EVAL_HPP
+#define RLSS_INTERNAL_BATCH_EVAL_HPP
+
+#include <rlss/internal/Util.hpp>
+#include <splx/curve/PiecewiseCurve.hpp>
+#include <absl/strings/str_cat.h>
+
+namespace rlss {
+namespace internal {
+
+template<typename T, unsigned int DIM>
+using MatrixDIMX = Eigen::Matrix<T, DIM, Eigen::Dynamic>;
+
+/*
+ * Bernstein basis matrix B of degree n for the given normalized parameters
+ * t in [0, 1] such that B(i, j) = C(n, i) * t_j^i * (1 - t_j)^(n - i).
+ * Rows are computed as whole arrays so that Eigen can vectorize them.
+ */
+template<typename T>
+Matrix<T> bernsteinBasisMatrix(
+    unsigned int n,
+    const Eigen::Ref<const Row<T>>& t
+) {
+    using Array = Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+    const Eigen::Index m = t.cols();
+
+    Array t_pow(n + 1, m);
+    Array s_pow(n + 1, m);
+    t_pow.row(0).setOnes();
+    s_pow.row(0).setOnes();
+    for(unsigned int i = 1; i <= n; i++) {
+        t_pow.row(i) = t_pow.row(i - 1) * t.array();
+        s_pow.row(i) = s_pow.row(i - 1) * (1 - t.array());
+    }
+
+    Matrix<T> basis(n + 1, m);
+    T binomial = 1;
+    for(unsigned int i = 0; i <= n; i++) {
+        basis.row(i) = (binomial * t_pow.row(i) * s_pow.row(n - i)).matrix();
+        binomial = binomial * (n - i) / (i + 1);
+    }
+
+    return basis;
+}
+
+/*
+ * Evaluates the k^th derivative of curve at all parameters in params and
+ * writes the results to the columns of result, i.e. result.col(j) is the
+ * k^th derivative of curve at params[j].
+ *
+ * params must be sorted in non-decreasing order and lie in
+ * [0, curve.maxParameter()]. Each piece is located once and its samples are
+ * evaluated with a single (hodograph control points) x (Bernstein basis)
+ * matrix product instead of one de Casteljau run per parameter. Derivatives
+ * with k > 0 on a zero duration last piece are zero.
+ */
+template<typename T, unsigned int DIM>
+void batchEval(
+    const splx::PiecewiseCurve<T, DIM>& curve,
+    const std::vector<T>& params,
+    unsigned int k,
+    MatrixDIMX<T, DIM>& result
+) {
+    using Bezier = splx::Bezier<T, DIM>;
+
+    result.resize(DIM, params.size());
+
+    if(params.empty()) {
+        return;
+    }
+
+    if(curve.numPieces() == 0) {
+        throw std::domain_error(
+            absl::StrCat(
+                "can't evaluate a curve with no pieces"
+            )
+        );
+    }
+
+    for(std::size_t j = 1; j < params.size(); j++) {
+        if(params[j] < params[j - 1]) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "batch evaluation parameters must be sorted",
+                    ", params[",
+                    j - 1,
+                    "]: ",
+                    params[j - 1],
+                    ", params[",
+                    j,
+                    "]: ",
+                    params[j]
+                )
+            );
+        }
+    }
+
+    if(params.front() < 0 || params.back() > curve.maxParameter()) {
+        throw std::domain_error(
+            absl::StrCat(
+                "batch evaluation parameters out of range [0, ",
+                curve.maxParameter(),
+                "], first: ",
+                params.front(),
+                ", last: ",
+                params.back()
+            )
+        );
+    }
+
+    std::size_t sample_idx = 0;
+    T piece_start = 0;
+    for(
+        std::size_t p_idx = 0;
+        p_idx < curve.numPieces() && sample_idx < params.size();
+        p_idx++
+    ) {
+        const Bezier& piece = curve[p_idx];
+        const T duration = piece.maxParameter();
+        const T piece_end = piece_start + duration;
+        const bool last_piece = (p_idx + 1 == curve.numPieces());
+
+        if(duration == 0 && !last_piece) {
+            continue;
+        }
+
+        std::size_t sample_end = sample_idx;
+        while(sample_end < params.size()
+              && (last_piece || params[sample_end] <= piece_end)) {
+            sample_end++;
+        }
+
+        const Eigen::Index sample_count = sample_end - sample_idx;
+        if(sample_count == 0) {
+            piece_start = piece_end;
+            continue;
+        }
+
+        // derivatives of a zero duration piece, which can only be the last
+        // one here, are taken to be zero
+        const Eigen::Index num_cpts = piece.numControlPoints();
+        if(static_cast<Eigen::Index>(k) >= num_cpts
+           || (k > 0 && duration == 0)) {
+            result.middleCols(sample_idx, sample_count).setZero();
+            sample_idx = sample_end;
+            piece_start = piece_end;
+            continue;
+        }
+
+        // control points of the k^th derivative (hodograph) of the piece
+        MatrixDIMX<T, DIM> cpts(DIM, num_cpts);
+        for(Eigen::Index i = 0; i < num_cpts; i++) {
+            cpts.col(i) = piece[i];
+        }
+        for(unsigned int d = 0; d < k; d++) {
+            const Eigen::Index m = cpts.cols() - 1;
+            MatrixDIMX<T, DIM> diff
+                = (cpts.rightCols(m) - cpts.leftCols(m)) * (T(m) / duration);
+            cpts = std::move(diff);
+        }
+
+        Row<T> t(sample_count);
+        for(Eigen::Index j = 0; j < sample_count; j++) {
+            t(j) = duration == 0
+                   ? T(0)
+                   : std::min(
+                        T(1),
+                        std::max(
+                            T(0),
+                            (params[sample_idx + j] - piece_start) / duration
+                        )
+                   );
+        }
+
+        result.middleCols(sample_idx, sample_count).noalias()
+            = cpts * bernsteinBasisMatrix<T>(cpts.cols() - 1, t);
+
+        sample_idx = sample_end;
+        piece_start = piece_end;
+    }
+}
+
+template<typename T, unsigned int DIM>
+MatrixDIMX<T, DIM> batchEval(
+    const splx::PiecewiseCurve<T, DIM>& curve,
+    const std::vector<T>& params,
+    unsigned int k
+) {
+    MatrixDIMX<T, DIM> result;
+    batchEval<T, DIM>(curve, params, k, result);
+    return result;
+}
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_BATCH_EVAL_HPP
@@ -0,0 +1,197 @@
+#ifndef RLSS_INTERNAL_COST_HESSIAN_HPP
+#define RLSS_INTERNAL_COST_HESSIAN_HPP
+
+#include <rlss/internal/Util.hpp>
+#include <splx/opt/PiecewiseCurveQPGenerator.hpp>
+#include <array>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Per thread cache of the Hessians H of the integrated squared derivative
+ * costs of single dimensional Bezier curves, i.e.
+ * int_0^tau |x^(k)(t)|^2 dt = P^T H P for the control points P.
+ *
+ * Only the matrices for tau = 1 are stored, keyed by (degree, derivative
+ * degree). Substituting t = tau * u gives H(tau) = tau^(1 - 2k) * H(1), so
+ * the matrices of any duration are scaled from the cached ones. Each thread
+ * has its own cache so that planners running in parallel do not contend.
+ */
+template<typename T>
+class CostHessianCache {
+public:
+    static CostHessianCache& instance() {
+        static thread_local CostHessianCache cache;
+        return cache;
+    }
+
+    // Hessian of int_0^duration |x^(k)(t)|^2 dt for a Bezier curve of
+    // degree n with the given duration. zero for zero durations.
+    Matrix<T> hessian(unsigned int n, unsigned int k, T duration) {
+        if(!(duration > 0)) {
+            return Matrix<T>::Zero(n + 1, n + 1);
+        }
+        return std::pow(duration, T(1) - T(2) * k) * this->unitHessian(n, k);
+    }
+
+    // Hessian for duration 1. the reference stays valid for the lifetime of
+    // the calling thread.
+    const Matrix<T>& unitHessian(unsigned int n, unsigned int k) {
+        auto it = m_hessians.find({n, k});
+        if(it == m_hessians.end()) {
+            it = m_hessians.emplace(
+                    std::make_pair(n, k), computeUnitHessian(n, k)).first;
+        }
+        return it->second;
+    }
+
+    std::size_t size() const {
+        return m_hessians.size();
+    }
+
+    static Matrix<T> computeUnitHessian(unsigned int n, unsigned int k) {
+        if(k > n) {
+            return Matrix<T>::Zero(n + 1, n + 1);
+        }
+
+        // x^(k)(u) = n! / (n - k)! * sum_i (Delta^k P)_i B_i^(n-k)(u)
+        const unsigned int m = n - k;
+        Matrix<T> diff = Matrix<T>::Identity(n + 1, n + 1);
+        T factor = 1;
+        for(unsigned int i = 0; i < k; i++) {
+            const Eigen::Index rows = diff.rows() - 1;
+            diff = (diff.bottomRows(rows) - diff.topRows(rows)).eval();
+            factor *= n - i;
+        }
+
+        // Gram matrix of the Bernstein basis of degree m on [0, 1]
+        Matrix<T> gram(m + 1, m + 1);
+        for(unsigned int i = 0; i <= m; i++) {
+            for(unsigned int j = 0; j <= m; j++) {
+                gram(i, j) = binomial(m, i) * binomial(m, j)
+                        / (binomial(2 * m, i + j) * (2 * m + 1));
+            }
+        }
+
+        return factor * factor * diff.transpose() * gram * diff;
+    }
+
+private:
+    CostHessianCache() = default;
+
+    static T binomial(unsigned int n, unsigned int k) {
+        T result = 1;
+        for(unsigned int i = 0; i < k; i++) {
+            result = result * (n - i) / (i + 1);
+        }
+        return result;
+    }
+
+    std::map<std::pair<unsigned int, unsigned int>, Matrix<T>> m_hessians;
+}; // class CostHessianCache
+
+/*
+ * Indexes of the decision variables of the control points given the curve
+ * qpgen extracts from the vector of the indexes of num_vars variables.
+ * Empty if the extracted values are not a permutation of the variables.
+ */
+template<typename T, unsigned int DIM>
+std::vector<std::vector<std::array<Eigen::Index, DIM>>> controlPointIndexes(
+        const splx::PiecewiseCurve<T, DIM>& indexes,
+        Eigen::Index num_vars) {
+    std::vector<std::vector<std::array<Eigen::Index, DIM>>> result(
+            indexes.numPieces());
+    std::vector<bool> seen(num_vars, false);
+    for(std::size_t p = 0; p < indexes.numPieces(); p++) {
+        const auto& piece = indexes[p];
+        for(std::size_t i = 0; i < piece.numControlPoints(); i++) {
+            std::array<Eigen::Index, DIM> cpt_indexes;
+            for(unsigned int d = 0; d < DIM; d++) {
+                const T value = piece[i](d);
+                const Eigen::Index index = std::llround(value);
+                if(index < 0 || index >= num_vars || seen[index]
+                   || std::abs(value - index) > T(1e-6)) {
+                    return {};
+                }
+                seen[index] = true;
+                cpt_indexes[d] = index;
+            }
+            result[p].push_back(cpt_indexes);
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Adds lambda * int |x^(k)(t)|^2 dt over all pieces of qpgen to the cost of
+ * its problem for each (k, lambda) of lambdas using the cached Hessians.
+ * Equivalent to calling qpgen.addIntegratedSquaredDerivativeCost(k, lambda)
+ * for each of them, which it falls back to if the indexes of the control
+ * points can not be read back.
+ *
+ * The control point indexes are read back through extractCurve and a dense
+ * num_vars x num_vars matrix is added to the problem once for all weights.
+ * It is used by generate_optimization_problem only if
+ * ENABLE_RLSS_CACHED_COST_HESSIANS is defined, as it is not shown to be
+ * faster than splx. examples/cost_hessian_benchmark.cpp compares the two.
+ */
+template<typename T, unsigned int DIM>
+void addIntegratedSquaredDerivativeCosts(
+        splx::PiecewiseCurveQPGenerator<T, DIM>& qpgen,
+        const std::vector<std::pair<unsigned int, T>>& lambdas) {
+    if(lambdas.empty()) {
+        return;
+    }
+
+    auto& problem = qpgen.getProblem();
+    const Eigen::Index num_vars = problem.num_vars();
+    const splx::PiecewiseCurve<T, DIM> index_curve = qpgen.extractCurve(
+            Vector<T>::LinSpaced(num_vars, 0, num_vars - 1));
+    const auto indexes = controlPointIndexes<T, DIM>(index_curve, num_vars);
+    if(indexes.empty() && index_curve.numPieces() > 0) {
+        for(const auto& [k, lambda]: lambdas) {
+            qpgen.addIntegratedSquaredDerivativeCost(k, lambda);
+        }
+        return;
+    }
+
+    // add_Q takes a dense matrix. it is kept between calls of the thread.
+    static thread_local Matrix<T> Q;
+    Q.setZero(num_vars, num_vars);
+
+    CostHessianCache<T>& cache = CostHessianCache<T>::instance();
+    for(std::size_t p = 0; p < indexes.size(); p++) {
+        const auto& piece = indexes[p];
+        if(piece.empty()) {
+            continue;
+        }
+
+        // problem cost is 1/2 x^T Q x
+        Matrix<T> H = Matrix<T>::Zero(piece.size(), piece.size());
+        for(const auto& [k, lambda]: lambdas) {
+            H += 2 * lambda * cache.hessian(
+                    piece.size() - 1, k, index_curve[p].maxParameter());
+        }
+
+        for(std::size_t i = 0; i < piece.size(); i++) {
+            for(std::size_t j = 0; j < piece.size(); j++) {
+                for(unsigned int d = 0; d < DIM; d++) {
+                    Q(piece[i][d], piece[j][d]) += H(i, j);
+                }
+            }
+        }
+    }
+
+    problem.add_Q(Q);
+}
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_COST_HESSIAN_HPP
@@ -0,0 +1,79 @@
+#ifndef RLSS_INTERNAL_DEADLINE_HPP
+#define RLSS_INTERNAL_DEADLINE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace rlss {
+namespace internal {
+
+// thrown by planning stages that give up because their deadline expired
+class DeadlineExpired: public std::runtime_error {
+public:
+    DeadlineExpired(): std::runtime_error("deadline expired") {
+
+    }
+};
+
+/*
+ * Point in time after which planning stages stop working and report
+ * failure. A default constructed deadline never expires.
+ */
+class Deadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Deadline() = default;
+
+    explicit Deadline(Clock::time_point time_point)
+        : m_time_point(time_point)
+    {
+
+    }
+
+    // deadline duration from now
+    template<typename Rep, typename Period>
+    static Deadline after(const std::chrono::duration<Rep, Period>& duration) {
+        return Deadline(
+            Clock::now()
+            + std::chrono::duration_cast<Clock::duration>(duration)
+        );
+    }
+
+    bool isSet() const {
+        return m_time_point.has_value();
+    }
+
+    bool expired() const {
+        return m_time_point && Clock::now() >= *m_time_point;
+    }
+
+    void throwIfExpired() const {
+        if(this->expired()) {
+            throw DeadlineExpired();
+        }
+    }
+
+    // remaining seconds, infinity if the deadline is not set
+    template<typename T>
+    T remainingSeconds() const {
+        if(!m_time_point) {
+            return std::numeric_limits<T>::infinity();
+        }
+        return std::max(
+            T(0),
+            std::chrono::duration<T>(*m_time_point - Clock::now()).count()
+        );
+    }
+
+private:
+    std::optional<Clock::time_point> m_time_point;
+}; // class Deadline
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_DEADLINE_HPP
@@ -0,0 +1,255 @@
+#ifndef RLSS_INTERNAL_DENSE_OCCUPANCY_GRID_HPP
+#define RLSS_INTERNAL_DENSE_OCCUPANCY_GRID_HPP
+
+#include <rlss/OccupancyGrid.hpp>
+#include <rlss/internal/Util.hpp>
+#include <absl/strings/str_cat.h>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Dense, linearly indexed box of occupancy grid indexes covering a region.
+ * Index i maps to the linear index sum_d (i(d) - minIndex()(d)) * stride(d).
+ */
+template<typename T, unsigned int DIM>
+class DenseIndexRegion {
+public:
+    using OccupancyGrid = rlss::OccupancyGrid<T, DIM>;
+    using Index = typename OccupancyGrid::Index;
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+
+    DenseIndexRegion(const OccupancyGrid& grid, const AlignedBox& region)
+        : m_min_index(grid.getIndex(region.min())),
+          m_max_index(grid.getIndex(region.max()))
+    {
+        m_size = 1;
+        for(unsigned int d = 0; d < DIM; d++) {
+            if(m_min_index(d) > m_max_index(d)) {
+                throw std::domain_error(
+                    absl::StrCat(
+                        "dense index region is empty at dimension ",
+                        d
+                    )
+                );
+            }
+            m_extent(d) = m_max_index(d) - m_min_index(d) + 1;
+            m_stride(d) = m_size;
+            m_size *= m_extent(d);
+        }
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    const Index& minIndex() const {
+        return m_min_index;
+    }
+
+    const Index& maxIndex() const {
+        return m_max_index;
+    }
+
+    long long int stride(unsigned int d) const {
+        return m_stride(d);
+    }
+
+    long long int extent(unsigned int d) const {
+        return m_extent(d);
+    }
+
+    bool contains(const Index& idx) const {
+        for(unsigned int d = 0; d < DIM; d++) {
+            if(idx(d) < m_min_index(d) || idx(d) > m_max_index(d)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t linearIndex(const Index& idx) const {
+        std::size_t lin = 0;
+        for(unsigned int d = 0; d < DIM; d++) {
+            lin += (idx(d) - m_min_index(d)) * m_stride(d);
+        }
+        return lin;
+    }
+
+    Index index(std::size_t lin) const {
+        Index idx;
+        for(unsigned int d = 0; d < DIM; d++) {
+            idx(d) = m_min_index(d) + (lin / m_stride(d)) % m_extent(d);
+        }
+        return idx;
+    }
+
+private:
+    Index m_min_index;
+    Index m_max_index;
+    Index m_extent;
+    Index m_stride;
+    std::size_t m_size;
+}; // class DenseIndexRegion
+
+/*
+ * Dense snapshot of the occupied cells of an OccupancyGrid inside a region.
+ * Keeps DIM dimensional prefix sums of the occupied cells so that the
+ * occupancy of an aligned box can be queried with 2^DIM lookups instead of
+ * visiting every cell in the box. Temporary obstacles of the grid are not
+ * part of the snapshot.
+ */
+template<typename T, unsigned int DIM>
+class DenseOccupancyGrid: public DenseIndexRegion<T, DIM> {
+public:
+    using Base = DenseIndexRegion<T, DIM>;
+    using OccupancyGrid = typename Base::OccupancyGrid;
+    using Index = typename Base::Index;
+    using AlignedBox = typename Base::AlignedBox;
+
+    DenseOccupancyGrid(const OccupancyGrid& grid, const AlignedBox& region)
+        : Base(grid, region),
+          m_grid_cells_id(grid.cellsId())
+    {
+        m_prefix_sums.assign(this->size(), 0);
+        for(const Index& idx: grid.getIndexSet()) {
+            if(this->contains(idx)) {
+                m_prefix_sums[this->linearIndex(idx)] = 1;
+            }
+        }
+
+        for(unsigned int d = 0; d < DIM; d++) {
+            const std::size_t stride = this->stride(d);
+            const std::size_t extent = this->extent(d);
+            for(std::size_t lin = 0; lin < this->size(); lin++) {
+                if((lin / stride) % extent != 0) {
+                    m_prefix_sums[lin] += m_prefix_sums[lin - stride];
+                }
+            }
+        }
+    }
+
+    // OccupancyGrid::cellsId of the grid the region was built from
+    std::uint64_t gridCellsId() const {
+        return m_grid_cells_id;
+    }
+
+    // number of occupied cells with indexes in [min, max]. min and max must
+    // be contained in the region.
+    std::uint32_t occupiedCount(const Index& min, const Index& max) const {
+        const Index& region_min = this->minIndex();
+        std::int64_t count = 0;
+        for(unsigned int corner = 0; corner < (1u << DIM); corner++) {
+            std::size_t lin = 0;
+            bool outside = false;
+            int sign = 1;
+            for(unsigned int d = 0; d < DIM; d++) {
+                long long int c = max(d);
+                if(corner & (1u << d)) {
+                    c = min(d) - 1;
+                    sign = -sign;
+                }
+                if(c < region_min(d)) {
+                    outside = true;
+                    break;
+                }
+                lin += (c - region_min(d)) * this->stride(d);
+            }
+            if(!outside) {
+                count += sign * static_cast<std::int64_t>(m_prefix_sums[lin]);
+            }
+        }
+        return count;
+    }
+
+    // whether any cell with index in [min, max] is occupied. cells that are
+    // outside of the region are considered occupied.
+    bool isOccupied(const Index& min, const Index& max) const {
+        if(!this->contains(min) || !this->contains(max)) {
+            return true;
+        }
+        return this->occupiedCount(min, max) != 0;
+    }
+
+private:
+    std::uint64_t m_grid_cells_id;
+
+    std::vector<std::uint32_t> m_prefix_sums;
+}; // class DenseOccupancyGrid
+
+/*
+ * Set of the indexes of a dense region stored as one bit per index.
+ */
+template<typename T, unsigned int DIM>
+class IndexBitmap: public DenseIndexRegion<T, DIM> {
+public:
+    using Base = DenseIndexRegion<T, DIM>;
+    using OccupancyGrid = typename Base::OccupancyGrid;
+    using Index = typename Base::Index;
+    using AlignedBox = typename Base::AlignedBox;
+    using UnorderedIndexSet = typename OccupancyGrid::UnorderedIndexSet;
+
+    explicit IndexBitmap(const Base& region)
+        : Base(region),
+          m_bits((region.size() + 63) / 64, 0)
+    {
+
+    }
+
+    IndexBitmap(const OccupancyGrid& grid, const AlignedBox& region)
+        : IndexBitmap(Base(grid, region))
+    {
+
+    }
+
+    bool test(std::size_t lin) const {
+        return (m_bits[lin >> 6] >> (lin & 63)) & 1;
+    }
+
+    // sets the bit and returns whether it was not set before
+    bool set(std::size_t lin) {
+        std::uint64_t mask = std::uint64_t(1) << (lin & 63);
+        bool was_set = m_bits[lin >> 6] & mask;
+        m_bits[lin >> 6] |= mask;
+        return !was_set;
+    }
+
+    // whether idx is in the set. indexes outside of the region are not.
+    bool contains(const Index& idx) const {
+        return Base::contains(idx) && this->test(this->linearIndex(idx));
+    }
+
+    std::size_t count() const {
+        std::size_t result = 0;
+        for(std::uint64_t word: m_bits) {
+            result += std::bitset<64>(word).count();
+        }
+        return result;
+    }
+
+    UnorderedIndexSet toIndexSet() const {
+        UnorderedIndexSet result;
+        for(std::size_t w = 0; w < m_bits.size(); w++) {
+            if(m_bits[w] == 0) {
+                continue;
+            }
+            for(std::size_t b = 0; b < 64; b++) {
+                if((m_bits[w] >> b) & 1) {
+                    result.insert(this->index(w * 64 + b));
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::uint64_t> m_bits;
+}; // class IndexBitmap
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_DENSE_OCCUPANCY_GRID_HPP
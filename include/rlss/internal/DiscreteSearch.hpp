@@ -4,6 +4,7 @@
 #include <rlss/internal/Util.hpp>
 #include <rlss/OccupancyGrid.hpp>
 #include <rlss/CollisionShapes/CollisionShape.hpp>
+#include <rlss/internal/Deadline.hpp>
 #include <libMultiRobotPlanning/a_star.hpp>
 #include <boost/functional/hash/hash.hpp>
 #include <optional>
@@ -22,7 +23,8 @@ std::optional<StdVectorVectorDIM<T, DIM>> discreteSearch(
             const typename OccupancyGrid<T, DIM>::Coordinate& goal_coordinate,
             const OccupancyGrid<T, DIM>& occupancy_grid,
             const AlignedBox<T, DIM>& workspace,
-            std::shared_ptr<rlss::CollisionShape<T,DIM>> collision_shape
+            std::shared_ptr<rlss::CollisionShape<T,DIM>> collision_shape,
+            const Deadline& deadline = Deadline()
 ) {
     using VectorDIM = VectorDIM<T, DIM>;
     using OccupancyGrid = OccupancyGrid<T, DIM>;
@@ -67,12 +69,14 @@ std::optional<StdVectorVectorDIM<T, DIM>> discreteSearch(
             const OccupancyGrid& occ, 
             const AlignedBox& works, 
             std::shared_ptr<CollisionShape> cols,
-            const Coordinate& goal
+            const Coordinate& goal,
+            const Deadline& dl
             )
             : m_occupancy_grid(occ),
               m_workspace(works),
               m_collision_shape(cols),
-              m_goal(goal)
+              m_goal(goal),
+              m_deadline(dl)
         {}
 
         int admissibleHeuristic(const State& s) {
@@ -95,6 +99,11 @@ std::optional<StdVectorVectorDIM<T, DIM>> discreteSearch(
 
             neighbors.clear();
 
+            // without neighbors, the search runs out of nodes and fails
+            if(m_deadline.expired()) {
+                return;
+            }
+
             Coordinate s_center = m_occupancy_grid.getCenter(s.position);
             Index s_idx = m_occupancy_grid.getIndex(s_center);
 
@@ -220,13 +229,15 @@ std::optional<StdVectorVectorDIM<T, DIM>> discreteSearch(
         const AlignedBox& m_workspace;
         std::shared_ptr<CollisionShape> m_collision_shape;
         const Coordinate& m_goal;
+        const Deadline& m_deadline;
     };
 
     Environment env(
             occupancy_grid,
             workspace,
             collision_shape,
-            goal_coordinate
+            goal_coordinate,
+            deadline
     );
     libMultiRobotPlanning::AStar<State, Action, int, Environment, StateHasher>
             astar(env);
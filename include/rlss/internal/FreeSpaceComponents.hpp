@@ -0,0 +1,126 @@
+#ifndef RLSS_INTERNAL_FREE_SPACE_COMPONENTS_HPP
+#define RLSS_INTERNAL_FREE_SPACE_COMPONENTS_HPP
+
+#include <rlss/OccupancyGrid.hpp>
+#include <rlss/CollisionShapes/CollisionShape.hpp>
+#include <rlss/internal/DenseOccupancyGrid.hpp>
+#include <rlss/internal/Util.hpp>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Connected component labels of the occupancy grid cells in a workspace for
+ * a collision shape. Two neighboring cells are connected if the robot can
+ * move between their centers, i.e. if segmentValid holds between them.
+ * Hence, a cell is reachable from another cell by internal::BFS iff both
+ * have the same label.
+ *
+ * Only the occupied cells of the grid are considered, temporary obstacles
+ * are ignored. Labels are recomputed by update() when the occupied cells of
+ * the grid change.
+ */
+template<typename T, unsigned int DIM>
+class FreeSpaceComponents {
+public:
+    using OccupancyGrid = rlss::OccupancyGrid<T, DIM>;
+    using Index = typename OccupancyGrid::Index;
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+    using CollisionShape = rlss::CollisionShape<T, DIM>;
+    using DenseOccupancyGrid = internal::DenseOccupancyGrid<T, DIM>;
+    using Label = std::uint32_t;
+
+    FreeSpaceComponents(
+        const AlignedBox& workspace,
+        std::shared_ptr<CollisionShape> collision_shape
+    ) : m_workspace(workspace),
+        m_collision_shape(collision_shape)
+    {
+
+    }
+
+    // recomputes labels if they are not computed for the current occupied
+    // cells of the grid. overlays of a grid share its labels.
+    void update(const OccupancyGrid& grid) {
+        if(m_dense_grid && m_dense_grid->gridCellsId() == grid.cellsId()) {
+            return;
+        }
+
+        m_dense_grid.emplace(grid, m_workspace);
+
+        const std::size_t size = m_dense_grid->size();
+        std::vector<Label> parent(size);
+        std::iota(parent.begin(), parent.end(), Label(0));
+
+        for(std::size_t lin = 0; lin < size; lin++) {
+            Index idx = m_dense_grid->index(lin);
+            AlignedBox from_box
+                    = m_collision_shape->boundingBox(grid.getCenter(idx));
+
+            for(unsigned int d = 0; d < DIM; d++) {
+                Index neigh_idx = idx;
+                neigh_idx(d)++;
+                if(neigh_idx(d) > m_dense_grid->maxIndex()(d)) {
+                    continue;
+                }
+
+                AlignedBox box = m_collision_shape->boundingBox(
+                        grid.getCenter(neigh_idx));
+                box.extend(from_box);
+
+                if(m_workspace.contains(box)
+                   && !m_dense_grid->isOccupied(
+                           grid.getIndex(box.min()),
+                           grid.getIndex(box.max()))) {
+                    Label a = find(parent, lin);
+                    Label b = find(parent, lin + m_dense_grid->stride(d));
+                    parent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+
+        m_labels.resize(size);
+        for(std::size_t lin = 0; lin < size; lin++) {
+            m_labels[lin] = find(parent, lin);
+        }
+    }
+
+    // label of the cell. std::nullopt if the cell is outside the workspace
+    // or update() is never called.
+    std::optional<Label> label(const Index& idx) const {
+        if(!m_dense_grid || !m_dense_grid->contains(idx)) {
+            return std::nullopt;
+        }
+        return m_labels[m_dense_grid->linearIndex(idx)];
+    }
+
+    bool connected(const Index& a, const Index& b) const {
+        std::optional<Label> la = this->label(a);
+        std::optional<Label> lb = this->label(b);
+        return la && lb && *la == *lb;
+    }
+
+private:
+    AlignedBox m_workspace;
+    std::shared_ptr<CollisionShape> m_collision_shape;
+
+    std::optional<DenseOccupancyGrid> m_dense_grid;
+    std::vector<Label> m_labels;
+
+    static Label find(std::vector<Label>& parent, Label x) {
+        while(parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+}; // class FreeSpaceComponents
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_FREE_SPACE_COMPONENTS_HPP
@@ -3,7 +3,14 @@
 
 #include "../../../third_party/json.hpp"
 #include <rlss/internal/Util.hpp>
+#include <rlss/internal/JSONLinesWriter.hpp>
+#include <rlss/OccupancyGrid.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <memory>
 #include <splx/curve/PiecewiseCurve.hpp>
 
 namespace rlss {
@@ -11,6 +18,258 @@ namespace rlss {
 
         namespace jsonbuilder {
             long long int file_count = 0;
+
+            enum class Format {
+                JSON,
+                // same document as JSON in binary, floats in single
+                // precision
+                CBOR,
+                // CBOR of the packed document, see pack
+                PackedCBOR
+            };
+
+            inline void writeCBORHead(
+                std::uint8_t major_type,
+                std::uint64_t value,
+                std::vector<std::uint8_t>& out
+            ) {
+                const std::uint8_t type = major_type << 5;
+                int num_bytes;
+                if(value < 24) {
+                    out.push_back(type | static_cast<std::uint8_t>(value));
+                    return;
+                } else if(value <= 0xFF) {
+                    out.push_back(type | 24);
+                    num_bytes = 1;
+                } else if(value <= 0xFFFF) {
+                    out.push_back(type | 25);
+                    num_bytes = 2;
+                } else if(value <= 0xFFFFFFFF) {
+                    out.push_back(type | 26);
+                    num_bytes = 4;
+                } else {
+                    out.push_back(type | 27);
+                    num_bytes = 8;
+                }
+                for(int i = num_bytes - 1; i >= 0; i--) {
+                    out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+                }
+            }
+
+            inline void writeCBORString(
+                const std::string& str,
+                std::vector<std::uint8_t>& out
+            ) {
+                writeCBORHead(3, str.size(), out);
+                out.insert(out.end(), str.begin(), str.end());
+            }
+
+            /*
+             * nlohmann::json::to_cbor writes doubles, which take 9 bytes.
+             * Single precision is enough for the viewers and takes 5.
+             */
+            inline void writeCBOR(
+                const nlohmann::json& json,
+                std::vector<std::uint8_t>& out
+            ) {
+                switch(json.type()) {
+                    case nlohmann::json::value_t::object:
+                        writeCBORHead(5, json.size(), out);
+                        for(auto it = json.begin(); it != json.end(); ++it) {
+                            writeCBORString(it.key(), out);
+                            writeCBOR(it.value(), out);
+                        }
+                        break;
+                    case nlohmann::json::value_t::array:
+                        writeCBORHead(4, json.size(), out);
+                        for(const auto& item: json) {
+                            writeCBOR(item, out);
+                        }
+                        break;
+                    case nlohmann::json::value_t::string:
+                        writeCBORString(
+                                json.get_ref<const std::string&>(), out);
+                        break;
+                    case nlohmann::json::value_t::number_unsigned:
+                        writeCBORHead(0, json.get<std::uint64_t>(), out);
+                        break;
+                    case nlohmann::json::value_t::number_integer: {
+                        const std::int64_t value = json.get<std::int64_t>();
+                        if(value >= 0) {
+                            writeCBORHead(0, value, out);
+                        } else {
+                            writeCBORHead(
+                                1, static_cast<std::uint64_t>(-(value + 1)),
+                                out);
+                        }
+                        break;
+                    }
+                    case nlohmann::json::value_t::number_float: {
+                        const float value
+                                = static_cast<float>(json.get<double>());
+                        std::uint32_t bits;
+                        std::memcpy(&bits, &value, sizeof(bits));
+                        out.push_back(0xFA);
+                        for(int i = 3; i >= 0; i--) {
+                            out.push_back(
+                                static_cast<std::uint8_t>(bits >> (8 * i)));
+                        }
+                        break;
+                    }
+                    case nlohmann::json::value_t::boolean:
+                        out.push_back(json.get<bool>() ? 0xF5 : 0xF4);
+                        break;
+                    default:
+                        out.push_back(0xF6);
+                        break;
+                }
+            }
+
+            inline void appendFlattened(
+                const nlohmann::json& vec,
+                nlohmann::json& out
+            ) {
+                for(const auto& value: vec) {
+                    out.push_back(value);
+                }
+            }
+
+            /*
+             * Packs a builder document so that frames repeat no keys. Each
+             * frame becomes an array in the order of frame_layout, with null
+             * for the fields the frame does not set, and vectors are
+             * flattened into float arrays:
+             *  robot_positions: dim floats per robot id, NaN if not set
+             *  trajectories: [robot_id, [[max_parameter, control points]],
+             *                 discrete path or null] per robot
+             *  obstacles: min and max of each box
+             *  hyperplanes: [robot_id, [piece_id], normal and distance of
+             *                each hyperplane] per robot
+             * Everything but the frames is kept as is.
+             */
+            inline nlohmann::json pack(
+                const nlohmann::json& document,
+                unsigned int dim
+            ) {
+                nlohmann::json packed = nlohmann::json::object();
+                for(auto it = document.begin(); it != document.end(); ++it) {
+                    if(it.key() != "frames") {
+                        packed[it.key()] = it.value();
+                    }
+                }
+                packed["encoding"] = "packed";
+                packed["dimension"] = dim;
+                packed["frame_layout"] = nlohmann::json::array({
+                    "step", "robot_positions", "trajectories",
+                    "obstacles", "hyperplanes"
+                });
+                packed["frames"] = nlohmann::json::array();
+
+                if(!document.contains("frames")) {
+                    return packed;
+                }
+
+                const std::size_t robot_count
+                        = document.value("robot_count", std::size_t(0));
+
+                for(const auto& frame: document["frames"]) {
+                    nlohmann::json packed_frame = nlohmann::json::array();
+                    packed_frame.push_back(frame["step"]);
+
+                    if(frame.contains("robot_positions")) {
+                        std::size_t count = robot_count;
+                        for(const auto& pos: frame["robot_positions"]) {
+                            count = std::max(count,
+                                    pos["robot_id"].get<std::size_t>() + 1);
+                        }
+                        nlohmann::json positions(
+                            count * dim,
+                            std::numeric_limits<double>::quiet_NaN()
+                        );
+                        for(const auto& pos: frame["robot_positions"]) {
+                            const std::size_t offset
+                                = pos["robot_id"].get<std::size_t>() * dim;
+                            for(unsigned int i = 0; i < dim; i++) {
+                                positions[offset + i] = pos["position"][i];
+                            }
+                        }
+                        packed_frame.push_back(positions);
+                    } else {
+                        packed_frame.push_back(nullptr);
+                    }
+
+                    if(frame.contains("trajectories")) {
+                        nlohmann::json trajectories = nlohmann::json::array();
+                        for(const auto& traj: frame["trajectories"]) {
+                            nlohmann::json pieces = nlohmann::json::array();
+                            for(const auto& piece: traj["trajectory"]) {
+                                nlohmann::json control_points
+                                        = nlohmann::json::array();
+                                for(const auto& cpt: piece["controlpoints"]) {
+                                    appendFlattened(cpt, control_points);
+                                }
+                                pieces.push_back(nlohmann::json::array({
+                                    piece["max_parameter"], control_points
+                                }));
+                            }
+
+                            nlohmann::json path = nullptr;
+                            if(traj.contains("discrete_path")
+                               && !traj["discrete_path"].is_null()) {
+                                path = nlohmann::json::array();
+                                for(const auto& pt: traj["discrete_path"]) {
+                                    appendFlattened(pt, path);
+                                }
+                            }
+
+                            trajectories.push_back(nlohmann::json::array({
+                                traj["robot_id"], pieces, path
+                            }));
+                        }
+                        packed_frame.push_back(trajectories);
+                    } else {
+                        packed_frame.push_back(nullptr);
+                    }
+
+                    if(frame.contains("obstacles")) {
+                        nlohmann::json obstacles = nlohmann::json::array();
+                        for(const auto& box: frame["obstacles"]) {
+                            appendFlattened(box["min"], obstacles);
+                            appendFlattened(box["max"], obstacles);
+                        }
+                        packed_frame.push_back(obstacles);
+                    } else {
+                        packed_frame.push_back(nullptr);
+                    }
+
+                    if(frame.contains("hyperplanes")) {
+                        nlohmann::json hyperplanes = nlohmann::json::array();
+                        for(const auto& robot_hps: frame["hyperplanes"]) {
+                            nlohmann::json piece_ids = nlohmann::json::array();
+                            nlohmann::json values = nlohmann::json::array();
+                            if(robot_hps.contains("hyperplanes")) {
+                                for(const auto& hp: robot_hps["hyperplanes"]) {
+                                    piece_ids.push_back(hp["piece_id"]);
+                                    appendFlattened(
+                                        hp["hyperplane"]["normal"], values);
+                                    values.push_back(
+                                        hp["hyperplane"]["distance"]);
+                                }
+                            }
+                            hyperplanes.push_back(nlohmann::json::array({
+                                robot_hps["robot_id"], piece_ids, values
+                            }));
+                        }
+                        packed_frame.push_back(hyperplanes);
+                    } else {
+                        packed_frame.push_back(nullptr);
+                    }
+
+                    packed["frames"].push_back(packed_frame);
+                }
+
+                return packed;
+            }
         }
 
 
@@ -29,8 +288,29 @@ namespace rlss {
             }
 
             void save(const std::string& filename) const {
-                std::ofstream file(filename, std::ios_base::out);
-                file << m_json;
+                this->save(filename, jsonbuilder::Format::JSON);
+            }
+
+            void save(
+                const std::string& filename,
+                jsonbuilder::Format format
+            ) const {
+                std::ofstream file(
+                        filename, std::ios_base::out | std::ios_base::binary);
+                if(format == jsonbuilder::Format::CBOR
+                   || format == jsonbuilder::Format::PackedCBOR) {
+                    std::vector<std::uint8_t> bytes;
+                    if(format == jsonbuilder::Format::PackedCBOR) {
+                        jsonbuilder::writeCBOR(
+                                jsonbuilder::pack(m_json, DIM), bytes);
+                    } else {
+                        jsonbuilder::writeCBOR(m_json, bytes);
+                    }
+                    file.write(reinterpret_cast<const char*>(bytes.data()),
+                               bytes.size());
+                } else {
+                    file << m_json;
+                }
                 file.close();
                 debug_message("written ", filename);
             }
@@ -76,8 +356,33 @@ namespace rlss {
                 m_json["frame_dt"] = dt;
             }
 
+            /*
+             * Appends frames to writer as they are completed instead of
+             * keeping them for save. The first line is a header with
+             * everything but the frames, written at the first nextFrame,
+             * so robots and frame dt must be set before that.
+             */
+            void streamTo(std::shared_ptr<JSONLinesWriter> writer) {
+                m_writer = std::move(writer);
+                m_header_written = false;
+            }
+
             void nextFrame() {
-                m_json["frames"].push_back(m_frame);
+                if(m_writer) {
+                    if(!m_header_written) {
+                        nlohmann::json header = m_json;
+                        header.erase("frames");
+                        header["type"] = "header";
+                        m_writer->write(std::move(header));
+                        m_header_written = true;
+                    }
+                    nlohmann::json frame;
+                    frame["type"] = "frame";
+                    frame["frame"] = m_frame;
+                    m_writer->write(std::move(frame));
+                } else {
+                    m_json["frames"].push_back(m_frame);
+                }
                 long long int step = m_frame["step"];
                 m_frame.clear();
                 m_frame["step"] = step + 1;
@@ -190,6 +495,9 @@ namespace rlss {
             nlohmann::json m_json;
             nlohmann::json m_frame;
 
+            std::shared_ptr<JSONLinesWriter> m_writer;
+            bool m_header_written = false;
+
 
             nlohmann::json toJSON(const VectorDIM& vec) const {
                 nlohmann::json vec_json;
@@ -245,6 +553,7 @@ namespace rlss {
                 for(const auto& pt: segments) {
                     seg_json.push_back(this->toJSON(pt));
                 }
+                return seg_json;
             }
 
             nlohmann::json toJSON(
@@ -272,6 +581,12 @@ namespace rlss {
             void save(const std::string& filename) const {
             }
 
+            void save(
+                const std::string& filename,
+                jsonbuilder::Format format
+            ) const {
+            }
+
             void save() const {
             }
 
@@ -293,6 +608,9 @@ namespace rlss {
             void setFrameDt(T dt) {
             }
 
+            void streamTo(std::shared_ptr<JSONLinesWriter> writer) {
+            }
+
             void nextFrame() {
             }
 
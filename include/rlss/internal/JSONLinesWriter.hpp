@@ -0,0 +1,116 @@
+#ifndef RLSS_INTERNAL_JSON_LINES_WRITER_HPP
+#define RLSS_INTERNAL_JSON_LINES_WRITER_HPP
+
+#include <rlss/internal/Util.hpp>
+#include "../../../third_party/json.hpp"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Appends json records to a file, one record per line, from a background
+ * thread. write only queues the record, serialization and file output
+ * happen in the writer thread, so the cost of writing a record does not
+ * depend on how many records are written before. write can be called from
+ * several threads. Records queued when the writer is destroyed are
+ * written before the destructor returns.
+ */
+class JSONLinesWriter {
+public:
+    // truncates filename
+    explicit JSONLinesWriter(const std::string& filename)
+        : m_file(filename, std::ios_base::out | std::ios_base::trunc)
+    {
+        if(!m_file) {
+            throw std::domain_error(
+                absl::StrCat("cannot open ", filename, " for writing")
+            );
+        }
+        m_writer = std::thread([this]() { this->writerLoop(); });
+    }
+
+    JSONLinesWriter(const JSONLinesWriter&) = delete;
+    JSONLinesWriter& operator=(const JSONLinesWriter&) = delete;
+
+    ~JSONLinesWriter() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_record_available.notify_all();
+        m_writer.join();
+    }
+
+    void write(nlohmann::json record) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(record));
+        }
+        m_record_available.notify_all();
+    }
+
+    // returns once all records written so far are in the file
+    void flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const std::size_t target = m_queued_count + m_queue.size();
+        m_record_written.wait(lock, [&]() {
+            return m_written_count >= target;
+        });
+    }
+
+private:
+    std::ofstream m_file;
+    std::thread m_writer;
+
+    std::mutex m_mutex;
+    std::condition_variable m_record_available;
+    std::condition_variable m_record_written;
+    std::vector<nlohmann::json> m_queue;
+    // number of records taken from the queue and written to the file
+    std::size_t m_queued_count = 0;
+    std::size_t m_written_count = 0;
+    bool m_stopping = false;
+
+    void writerLoop() {
+        std::vector<nlohmann::json> batch;
+        std::string line;
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_record_available.wait(lock, [this]() {
+                    return m_stopping || !m_queue.empty();
+                });
+                if(m_queue.empty()) {
+                    return;
+                }
+                batch.swap(m_queue);
+                m_queued_count += batch.size();
+            }
+
+            for(const nlohmann::json& record: batch) {
+                line = record.dump();
+                line.push_back('\n');
+                m_file.write(line.data(), line.size());
+            }
+            m_file.flush();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_written_count += batch.size();
+            }
+            m_record_written.notify_all();
+            batch.clear();
+        }
+    }
+}; // class JSONLinesWriter
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_JSON_LINES_WRITER_HPP
@@ -27,6 +27,7 @@ namespace rlss {
             MathematicaWriter(const std::string filename) {}
             const std::string& fileName() const {}
             void save() {}
+            void reset() {}
             void robotCollisionAvoidanceHyperplane(
                     const Hyperplane<T, DIM>& hp) {}
             void obstacleCollisionAvoidanceHyperplane(
@@ -95,6 +96,30 @@ namespace rlss {
                 file.close();
             }
 
+            // saves the commands written so far and continues with the next
+            // file, like a newly constructed writer. nothing is saved if
+            // nothing is written.
+            void reset() {
+                if(file.is_open() && file.tellp() == std::streampos(0)) {
+                    return;
+                }
+                if(file.is_open()) {
+                    save();
+                }
+
+                filename = "mathematica"
+                           + std::to_string(mathematica::file_count)
+                           + ".commands";
+                file.open(filename, std::ios_base::out);
+                rcah_count = 0;
+                ocah_count = 0;
+                orcb_count = 0;
+                ocb_count = 0;
+                dp_count = 0;
+                bez_count = 0;
+                ++mathematica::file_count;
+            }
+
             void robotCollisionAvoidanceHyperplane(const Hyperplane<T, 3U>& hp) {
                 std::string prefix = "rcah" + std::to_string(rcah_count++);
                 std::string normal = prefix + "normal";
@@ -0,0 +1,135 @@
+#ifndef RLSS_INTERNAL_MONOTONIC_ARENA_HPP
+#define RLSS_INTERNAL_MONOTONIC_ARENA_HPP
+
+#include <rlss/internal/Util.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Memory resource that hands out memory by bumping a pointer in large
+ * blocks and never frees individual allocations. reset releases all
+ * allocations at once. The blocks are kept, merged into one block that fits
+ * everything allocated since the previous reset, so that a workload that
+ * repeats after each reset does not allocate from the heap again.
+ */
+class MonotonicArena: public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(std::size_t initial_block_size = 4096)
+        : m_initial_block_size(std::max<std::size_t>(initial_block_size, 64)),
+          m_used(0)
+    {
+
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override {
+        this->releaseBlocks();
+    }
+
+    // releases all allocations made from the arena
+    void reset() {
+        if(m_blocks.size() > 1) {
+            std::size_t total_size = 0;
+            for(const Block& block: m_blocks) {
+                total_size += block.size;
+            }
+            this->releaseBlocks();
+            this->addBlock(total_size);
+        }
+        m_used = 0;
+    }
+
+    // total size of the blocks of the arena
+    std::size_t capacity() const {
+        std::size_t result = 0;
+        for(const Block& block: m_blocks) {
+            result += block.size;
+        }
+        return result;
+    }
+
+    std::size_t numBlocks() const {
+        return m_blocks.size();
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if(!m_blocks.empty()) {
+            if(void* ptr = this->bump(bytes, alignment)) {
+                return ptr;
+            }
+        }
+
+        std::size_t block_size = m_blocks.empty()
+                ? m_initial_block_size
+                : 2 * m_blocks.back().size;
+        this->addBlock(std::max(block_size, bytes + alignment));
+        return this->bump(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+            override {
+
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other)
+            const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    std::size_t m_initial_block_size;
+    std::vector<Block> m_blocks;
+    // number of used bytes of the last block
+    std::size_t m_used;
+
+    // returns nullptr if the last block does not have enough space
+    void* bump(std::size_t bytes, std::size_t alignment) {
+        Block& block = m_blocks.back();
+        void* ptr = block.data + m_used;
+        std::size_t space = block.size - m_used;
+        if(std::align(alignment, bytes, ptr, space) == nullptr) {
+            return nullptr;
+        }
+        m_used = block.size - space + bytes;
+        return ptr;
+    }
+
+    void addBlock(std::size_t size) {
+        m_blocks.push_back(
+            Block{static_cast<std::byte*>(::operator new(size)), size}
+        );
+        m_used = 0;
+    }
+
+    void releaseBlocks() {
+        for(const Block& block: m_blocks) {
+            ::operator delete(block.data);
+        }
+        m_blocks.clear();
+    }
+}; // class MonotonicArena
+
+// StdVectorVectorDIM whose elements live in a memory resource such as a
+// MonotonicArena
+template<typename T, unsigned int DIM>
+using PmrVectorVectorDIM = std::pmr::vector<VectorDIM<T, DIM>>;
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_MONOTONIC_ARENA_HPP
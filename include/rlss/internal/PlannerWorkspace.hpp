@@ -0,0 +1,145 @@
+#ifndef RLSS_INTERNAL_PLANNER_WORKSPACE_HPP
+#define RLSS_INTERNAL_PLANNER_WORKSPACE_HPP
+
+#include <rlss/internal/QPSolver.hpp>
+#include <rlss/internal/MonotonicArena.hpp>
+#include <rlss/internal/Statistics.hpp>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Objects kept alive across planning calls so that they are reused instead
+ * of being recreated on every call: QP solvers, and with them the
+ * environments of their backends, copies of QP problems, the statistics of
+ * a planning call, scratch buffers, and an arena for the geometric
+ * temporaries of a call. Problem copies and statistics are reset in place,
+ * so they keep their storage across calls.
+ *
+ * QP problems that rlss builds from scratch on every call, i.e. svm
+ * problems and soft versions of problems, are still allocated by
+ * QPWrappers::Problem, which can not be reset in place, and the problem of
+ * the PiecewiseCurveQPGenerator is rebuilt by its resetProblem in splx.
+ * tests/RLSS_allocation_test.cpp only checks that RLSS::plan itself does
+ * not allocate once its buffers are sized, using stub components.
+ *
+ * A workspace is used by one thread at a time. Solvers in different slots
+ * are different objects, so that solves of the same backend can run
+ * concurrently using different slots.
+ */
+template<typename T>
+class PlannerWorkspace {
+public:
+    using QPSolver = internal::QPSolver<T>;
+    using Problem = QPWrappers::Problem<T>;
+
+    // slots of the solvers of the different problems of a planning call.
+    // problems solved with the same backend get different solvers, so that
+    // no problem hotstarts from another one or inherits its tolerance and
+    // time limit.
+    static constexpr std::size_t TrajectorySlot = 0;
+    static constexpr std::size_t SvmSlot = 1;
+    // linear programs of redundant hyperplane pruning
+    static constexpr std::size_t LpSlot = 2;
+    // the concurrent soft solves of RLSSHardSoftOptimizer use SoftSlot and
+    // SoftSlot + 1
+    static constexpr std::size_t SoftSlot = 3;
+
+    PlannerWorkspace() = default;
+
+    // copies start with an empty workspace as solvers are not shared
+    PlannerWorkspace(const PlannerWorkspace&) {
+
+    }
+
+    PlannerWorkspace& operator=(const PlannerWorkspace&) {
+        return *this;
+    }
+
+    // solver of the QPSolverRegistry backend name in slot. created on the
+    // first call and returned on the later calls.
+    std::shared_ptr<QPSolver> solver(
+            const std::string& name,
+            std::size_t slot = 0
+    ) {
+        if(slot >= m_solvers.size()) {
+            m_solvers.resize(slot + 1);
+        }
+        auto it = m_solvers[slot].find(name);
+        if(it == m_solvers[slot].end()) {
+            it = m_solvers[slot].emplace(
+                    name,
+                    std::shared_ptr<QPSolver>(createQPSolver<T>(name))
+            ).first;
+        }
+        return it->second;
+    }
+
+    std::size_t numSolvers() const {
+        std::size_t result = 0;
+        for(const auto& slot: m_solvers) {
+            result += slot.size();
+        }
+        return result;
+    }
+
+    // count duration buffers. buffers keep their capacity between calls.
+    std::vector<std::vector<T>>& durationBuffers(std::size_t count) {
+        if(m_duration_buffers.size() < count) {
+            m_duration_buffers.resize(count);
+        }
+        return m_duration_buffers;
+    }
+
+    // copy of problem in slot. the copy is assigned in place, so it reuses
+    // the storage of the previous copy in the slot if the sizes are the
+    // same. valid until the next copy to the same slot, also while copies
+    // to other slots are made.
+    const Problem& problemCopy(const Problem& problem, std::size_t slot = 0) {
+        if(slot >= m_problems.size()) {
+            m_problems.resize(slot + 1);
+        }
+        if(m_problems[slot]) {
+            *m_problems[slot] = problem;
+        } else {
+            m_problems[slot].emplace(problem);
+        }
+        return *m_problems[slot];
+    }
+
+    // statistics of one planning call. the owner resets them at the start
+    // of each call.
+    DurationStatistics<T>& durationStatistics() {
+        return m_duration_statistics;
+    }
+
+    SuccessFailureStatistics<T>& sfStatistics() {
+        return m_sf_statistics;
+    }
+
+    // arena of the temporaries of one planning call. the owner resets it
+    // once the call is done.
+    MonotonicArena& arena() {
+        return m_arena;
+    }
+
+private:
+    std::vector<std::map<std::string, std::shared_ptr<QPSolver>>> m_solvers;
+    // deque, so that copies stay in place when slots are added
+    std::deque<std::optional<Problem>> m_problems;
+    std::vector<std::vector<T>> m_duration_buffers;
+    DurationStatistics<T> m_duration_statistics;
+    SuccessFailureStatistics<T> m_sf_statistics;
+    MonotonicArena m_arena;
+}; // class PlannerWorkspace
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_PLANNER_WORKSPACE_HPP
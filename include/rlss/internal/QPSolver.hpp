@@ -0,0 +1,329 @@
+#ifndef RLSS_INTERNAL_QP_SOLVER_HPP
+#define RLSS_INTERNAL_QP_SOLVER_HPP
+
+#include <qp_wrappers/problem.hpp>
+#ifdef ENABLE_RLSS_CPLEX
+#include <qp_wrappers/cplex.hpp>
+#endif
+#ifdef ENABLE_RLSS_GUROBI
+#include <qp_wrappers/gurobi.hpp>
+#endif
+#include <qp_wrappers/qpoases.hpp>
+#include <qp_wrappers/osqp.hpp>
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rlss {
+
+// names of the QPSolverRegistry backends used by the trajectory optimizers.
+// defaults are backends every build registers.
+struct QPSolverSelection {
+    // hard trajectory optimization problem
+    std::string hard = "qpoases";
+    // soft trajectory optimization problem
+    std::string soft = "qpoases";
+    // svm hyperplanes between the robot and obstacles or other robots
+    std::string svm = "qpoases";
+    // linear programs of redundant hyperplane pruning
+    std::string lp = "qpoases";
+};
+
+namespace internal {
+
+// durations of solver calls in microseconds with the names of the backends
+template<typename T>
+using SolverDurations = std::vector<std::pair<std::string, T>>;
+
+/*
+ * Backend agnostic interface of the QPWrappers engines. Linear programs are
+ * solved as problems without a quadratic cost term.
+ */
+template<typename T>
+class QPSolver {
+public:
+    using Problem = QPWrappers::Problem<T>;
+    using Vector = typename Problem::Vector;
+    using OptReturnType = QPWrappers::OptReturnType;
+
+    explicit QPSolver(const std::string& name)
+        : m_name(name),
+          m_last_solve_duration(0)
+    {
+
+    }
+
+    virtual ~QPSolver() {
+
+    }
+
+    const std::string& name() const {
+        return m_name;
+    }
+
+    // duration of the last call to init or next in microseconds
+    T lastSolveDuration() const {
+        return m_last_solve_duration;
+    }
+
+    OptReturnType init(const Problem& problem, Vector& soln) {
+        return this->timed([&]() {
+            return this->initImpl(problem, soln);
+        });
+    }
+
+    OptReturnType next(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) {
+        return this->timed([&]() {
+            return this->nextImpl(problem, soln, initial_guess);
+        });
+    }
+
+    virtual void setFeasibilityTolerance(T tolerance) = 0;
+
+    // whether requestStop makes a running solve return early
+    virtual bool supportsStop() const {
+        return false;
+    }
+
+    // asks a solve running on another thread to return early. backends that
+    // do not support stopping ignore it.
+    virtual void requestStop() {
+
+    }
+
+    // limits the duration of the following solves. infinity removes the
+    // limit. backends that cannot limit their solve time ignore it.
+    virtual void setTimeLimit(T seconds) {
+
+    }
+
+protected:
+    virtual OptReturnType initImpl(const Problem& problem, Vector& soln) = 0;
+    virtual OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) = 0;
+
+private:
+    std::string m_name;
+    T m_last_solve_duration;
+
+    template<typename F>
+    OptReturnType timed(F solve) {
+        auto start_time = std::chrono::steady_clock::now();
+        auto record = [&]() {
+            m_last_solve_duration
+                = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_time
+                  ).count();
+        };
+
+        try {
+            OptReturnType ret = solve();
+            record();
+            return ret;
+        } catch(...) {
+            record();
+            throw;
+        }
+    }
+}; // class QPSolver
+
+// whether Engine has setTimeLimit(T)
+template<typename T, typename Engine, typename = void>
+struct HasSetTimeLimit: std::false_type {};
+
+template<typename T, typename Engine>
+struct HasSetTimeLimit<
+        T,
+        Engine,
+        std::void_t<decltype(std::declval<Engine&>().setTimeLimit(T()))>
+>: std::true_type {};
+
+// whether Engine has requestStop(), which makes a solve running on another
+// thread return early
+template<typename Engine, typename = void>
+struct HasRequestStop: std::false_type {};
+
+template<typename Engine>
+struct HasRequestStop<
+        Engine,
+        std::void_t<decltype(std::declval<Engine&>().requestStop())>
+>: std::true_type {};
+
+// QPSolver of a QPWrappers engine such as QPWrappers::OSQP::Engine<T>
+template<typename T, typename Engine>
+class QPEngineSolver: public QPSolver<T> {
+public:
+    using Base = QPSolver<T>;
+    using Problem = typename Base::Problem;
+    using Vector = typename Base::Vector;
+    using OptReturnType = typename Base::OptReturnType;
+
+    explicit QPEngineSolver(const std::string& name): Base(name) {
+
+    }
+
+    void setFeasibilityTolerance(T tolerance) override {
+        m_engine.setFeasibilityTolerance(tolerance);
+    }
+
+    bool supportsStop() const override {
+        return HasRequestStop<Engine>::value;
+    }
+
+    void requestStop() override {
+        if constexpr(HasRequestStop<Engine>::value) {
+            m_engine.requestStop();
+        }
+    }
+
+    void setTimeLimit(T seconds) override {
+        if constexpr(HasSetTimeLimit<T, Engine>::value) {
+            m_engine.setTimeLimit(
+                    std::isfinite(seconds)
+                    ? seconds
+                    : std::numeric_limits<T>::max());
+        }
+    }
+
+protected:
+    OptReturnType initImpl(const Problem& problem, Vector& soln) override {
+        return m_engine.init(problem, soln);
+    }
+
+    OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) override {
+        return m_engine.next(problem, soln, initial_guess);
+    }
+
+private:
+    Engine m_engine;
+}; // class QPEngineSolver
+
+/*
+ * Process wide registry of QP backends by name. "qpoases" and "osqp" are
+ * registered by default, "cplex" and "gurobi" as well if the build enables
+ * them with ENABLE_RLSS_CPLEX and ENABLE_RLSS_GUROBI. Other backends can be
+ * registered at runtime, and registering an existing name replaces it.
+ */
+template<typename T>
+class QPSolverRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<QPSolver<T>>()>;
+
+    static QPSolverRegistry& instance() {
+        static QPSolverRegistry registry;
+        return registry;
+    }
+
+    void registerSolver(const std::string& name, Factory factory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_factories[name] = std::move(factory);
+    }
+
+    template<typename Engine>
+    void registerEngine(const std::string& name) {
+        this->registerSolver(name, [name]() {
+            return std::unique_ptr<QPSolver<T>>(
+                    new QPEngineSolver<T, Engine>(name));
+        });
+    }
+
+    bool contains(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_factories.find(name) != m_factories.end();
+    }
+
+    // sorted names of the registered backends
+    std::vector<std::string> names() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::string> result;
+        for(const auto& [name, factory]: m_factories) {
+            result.push_back(name);
+        }
+        return result;
+    }
+
+    std::unique_ptr<QPSolver<T>> create(const std::string& name) const {
+        Factory factory;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_factories.find(name);
+            if(it != m_factories.end()) {
+                factory = it->second;
+            }
+        }
+
+        if(!factory) {
+            throw this->notRegistered(name);
+        }
+
+        return factory();
+    }
+
+    // throws if any backend in selection is not registered
+    void validate(const QPSolverSelection& selection) const {
+        for(const std::string& name: {
+                selection.hard, selection.soft, selection.svm, selection.lp}) {
+            if(!this->contains(name)) {
+                throw this->notRegistered(name);
+            }
+        }
+    }
+
+private:
+    QPSolverRegistry() {
+#ifdef ENABLE_RLSS_CPLEX
+        this->registerEngine<QPWrappers::CPLEX::Engine<T>>("cplex");
+#endif
+#ifdef ENABLE_RLSS_GUROBI
+        this->registerEngine<QPWrappers::GUROBI::Engine<T>>("gurobi");
+#endif
+        this->registerEngine<QPWrappers::qpOASES::Engine<T>>("qpoases");
+        this->registerEngine<QPWrappers::OSQP::Engine<T>>("osqp");
+    }
+
+    std::domain_error notRegistered(const std::string& name) const {
+        return std::domain_error(
+            absl::StrCat(
+                "qp solver ",
+                name,
+                " is not registered. registered solvers: ",
+                absl::StrJoin(this->names(), ", ")
+            )
+        );
+    }
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Factory> m_factories;
+}; // class QPSolverRegistry
+
+template<typename T>
+std::unique_ptr<QPSolver<T>> createQPSolver(const std::string& name) {
+    return QPSolverRegistry<T>::instance().create(name);
+}
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_QP_SOLVER_HPP
@@ -2,12 +2,29 @@
 #define RLSS_INTERNAL_RLSS_OPTIMIZATION_HPP
 
 #include <rlss/CollisionShapes/CollisionShape.hpp>
+#include <rlss/OccupancyGrid.hpp>
 #include <splx/opt/PiecewiseCurveQPGenerator.hpp>
 #include <rlss/internal/Util.hpp>
 #include <rlss/internal/SVM.hpp>
+#include <rlss/internal/Deadline.hpp>
+#include <rlss/internal/QPSolver.hpp>
+#include <rlss/internal/PlannerWorkspace.hpp>
 #include <rlss/internal/MathematicaWriter.hpp>
+#include <rlss/internal/BatchEval.hpp>
+#include <rlss/internal/CostHessian.hpp>
+#include <optional>
 
 namespace rlss {
+
+// how robot to obstacle avoidance constraints of the pieces are generated
+enum class ObstacleConstraintGenerator {
+    // one svm hyperplane between the piece and each occupied cell within
+    // obstacle check distance
+    SVM,
+    // at most 2 * DIM faces of an obstacle free box grown around the piece
+    SafeCorridor
+};
+
 namespace internal {
 
 template<typename T, unsigned int DIM>
@@ -15,27 +32,45 @@ std::vector<Hyperplane<T, DIM>> robot_safety_hyperplanes(
         const VectorDIM<T, DIM>& robot_position,
         const std::vector<AlignedBox<T, DIM>>&
         other_robot_collision_shape_bounding_boxes,
-        std::shared_ptr<CollisionShape<T, DIM>> colshape) {
+        std::shared_ptr<CollisionShape<T, DIM>> colshape,
+        const std::string& svm_solver = "qpoases",
+        SolverDurations<T>* solver_durations = nullptr,
+        PlannerWorkspace<T>* workspace = nullptr,
+        const Deadline& deadline = Deadline()) {
 
     using Hyperplane = internal::Hyperplane<T, DIM>;
     using AlignedBox = internal::AlignedBox<T, DIM>;
-    using StdVectorVectorDIM = internal::StdVectorVectorDIM<T, DIM>;
+    using PmrVectorVectorDIM = internal::PmrVectorVectorDIM<T, DIM>;
 
     std::vector<Hyperplane> hyperplanes;
 
+    // corner points are temporaries of the workspace arena if there is one
+    std::pmr::memory_resource* resource
+            = workspace != nullptr
+              ? &workspace->arena()
+              : std::pmr::get_default_resource();
+
     AlignedBox robot_box
             = colshape->boundingBox(robot_position);
 
-    StdVectorVectorDIM robot_points
-            = rlss::internal::cornerPoints<T, DIM>(robot_box);
+    PmrVectorVectorDIM robot_points(resource);
+    rlss::internal::cornerPoints<T, DIM>(robot_box, robot_points);
 
+    PmrVectorVectorDIM oth_points(resource);
     for(const auto& oth_collision_shape_bbox:
             other_robot_collision_shape_bounding_boxes) {
-        StdVectorVectorDIM oth_points
-                = rlss::internal::cornerPoints<T, DIM>(oth_collision_shape_bbox);
+        deadline.throwIfExpired();
+
+        rlss::internal::cornerPoints<T, DIM>(
+                oth_collision_shape_bbox, oth_points);
 
 
-        Hyperplane svm_hp = rlss::internal::svm<T, DIM>(robot_points, oth_points);
+        Hyperplane svm_hp = rlss::internal::svm<T, DIM>(
+                robot_points,
+                oth_points,
+                svm_solver,
+                solver_durations,
+                workspace);
 
 
         Hyperplane svm_shifted = rlss::internal::shiftHyperplane<T, DIM>(
@@ -50,6 +85,241 @@ std::vector<Hyperplane<T, DIM>> robot_safety_hyperplanes(
     return hyperplanes;
 }
 
+/*
+ * Grows the obstacle free box box against the occupancy grid and returns the
+ * grown box. Faces are moved outwards one grid layer at a time in a round
+ * robin fashion as long as the swept layer is free, the box stays in the
+ * workspace, and faces are at most max_distance away from box.
+ */
+template<typename T, unsigned int DIM>
+AlignedBox<T, DIM> inflateFreeBox(
+    const OccupancyGrid<T, DIM>& occupancy_grid,
+    const AlignedBox<T, DIM>& workspace,
+    const AlignedBox<T, DIM>& box,
+    T max_distance
+) {
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+    using VectorDIM = internal::VectorDIM<T, DIM>;
+
+    const VectorDIM& step = occupancy_grid.getStepSize();
+
+    // layers are shrunk by a small amount so that cells that only touch a
+    // layer are not considered to be in it
+    const VectorDIM eps = step * 1e-6;
+
+    AlignedBox limits(
+            box.min().array() - max_distance,
+            box.max().array() + max_distance
+    );
+    limits = limits.intersection(workspace);
+
+    AlignedBox result = box;
+    bool growing[DIM][2];
+    for(unsigned int d = 0; d < DIM; d++) {
+        growing[d][0] = growing[d][1] = true;
+    }
+
+    bool any_growing = true;
+    while(any_growing) {
+        any_growing = false;
+        for(unsigned int d = 0; d < DIM; d++) {
+            for(unsigned int side = 0; side < 2; side++) {
+                if(!growing[d][side]) {
+                    continue;
+                }
+
+                AlignedBox layer = result;
+                if(side == 0) {
+                    T next = (std::ceil(result.min()(d) / step(d) - 1e-6) - 1)
+                            * step(d);
+                    next = std::max(next, limits.min()(d));
+                    layer.min()(d) = next;
+                    layer.max()(d) = result.min()(d);
+                } else {
+                    T next = (std::floor(result.max()(d) / step(d) + 1e-6) + 1)
+                            * step(d);
+                    next = std::min(next, limits.max()(d));
+                    layer.min()(d) = result.max()(d);
+                    layer.max()(d) = next;
+                }
+
+                if(layer.max()(d) <= layer.min()(d)
+                   || occupancy_grid.isOccupied(
+                        AlignedBox(layer.min() + eps, layer.max() - eps))) {
+                    growing[d][side] = false;
+                    continue;
+                }
+
+                result.extend(layer);
+                any_growing = true;
+            }
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Hyperplanes bounding the center of the robot with collision shape colshape
+ * to the box corridor, so that the robot is inside the corridor. Faces of the
+ * corridor that are not strictly inside bounds are not returned, e.g. the
+ * faces on the workspace boundary, which are covered by the workspace
+ * constraint, or faces that are at obstacle check distance.
+ */
+template<typename T, unsigned int DIM>
+std::vector<Hyperplane<T, DIM>> corridorHyperplanes(
+    const AlignedBox<T, DIM>& corridor,
+    const AlignedBox<T, DIM>& bounds,
+    std::shared_ptr<CollisionShape<T, DIM>> colshape
+) {
+    using VectorDIM = internal::VectorDIM<T, DIM>;
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+    using Hyperplane = internal::Hyperplane<T, DIM>;
+
+    AlignedBox center_box = bufferAlignedBox<T, DIM>(
+            VectorDIM::Zero(),
+            colshape->boundingBox(VectorDIM::Zero()),
+            corridor
+    );
+
+    std::vector<Hyperplane> hyperplanes;
+    for(unsigned int d = 0; d < DIM; d++) {
+        if(corridor.min()(d) > bounds.min()(d)) {
+            hyperplanes.emplace_back(
+                    -VectorDIM::Unit(d), center_box.min()(d));
+        }
+        if(corridor.max()(d) < bounds.max()(d)) {
+            hyperplanes.emplace_back(
+                    VectorDIM::Unit(d), -center_box.max()(d));
+        }
+    }
+    return hyperplanes;
+}
+
+/*
+ * Decision variables of qpgen for the curve c(t) = previous_curve(t +
+ * time_shift), which is previous_curve moved time_shift back in time and
+ * held at its end point after its max parameter. Each piece of qpgen is
+ * interpolated at uniformly spaced parameters, which is exact when c is a
+ * polynomial of at most the degree of the piece on the piece.
+ *
+ * segments_dvars are the decision variables qpgen generates for the
+ * segments, from which the number of control points of the pieces are
+ * read. Returns std::nullopt if previous_curve does not cover time_shift.
+ */
+template<typename T, unsigned int DIM>
+std::optional<Vector<T>> warmStartDecisionVariables(
+        const splx::PiecewiseCurveQPGenerator<T, DIM>& qpgen,
+        const Vector<T>& segments_dvars,
+        const splx::PiecewiseCurve<T, DIM>& previous_curve,
+        T time_shift) {
+    using PiecewiseCurve = splx::PiecewiseCurve<T, DIM>;
+
+    if(previous_curve.numPieces() == 0
+       || time_shift < 0
+       || time_shift > previous_curve.maxParameter()) {
+        return std::nullopt;
+    }
+
+    const PiecewiseCurve pieces = qpgen.extractCurve(segments_dvars);
+
+    std::vector<T> params;
+    T piece_start = time_shift;
+    for(std::size_t p = 0; p < pieces.numPieces(); p++) {
+        const std::size_t num_cpts = pieces[p].numControlPoints();
+        const T duration = pieces[p].maxParameter();
+        for(std::size_t j = 0; j < num_cpts; j++) {
+            T u = num_cpts == 1 ? T(0) : T(j) / (num_cpts - 1);
+            params.push_back(std::min(
+                    piece_start + u * duration,
+                    previous_curve.maxParameter()));
+        }
+        piece_start += duration;
+    }
+
+    const MatrixDIMX<T, DIM> samples
+            = batchEval<T, DIM>(previous_curve, params, 0);
+
+    Vector<T> dvars(segments_dvars.rows());
+    Eigen::Index offset = 0;
+    Eigen::Index sample_idx = 0;
+    for(std::size_t p = 0; p < pieces.numPieces(); p++) {
+        const Eigen::Index num_cpts = pieces[p].numControlPoints();
+        if(offset + num_cpts * DIM > dvars.rows()) {
+            return std::nullopt;
+        }
+
+        Row<T> u(num_cpts);
+        for(Eigen::Index j = 0; j < num_cpts; j++) {
+            u(j) = num_cpts == 1 ? T(0) : T(j) / (num_cpts - 1);
+        }
+
+        // samples = cpts * basis
+        Matrix<T> basis = bernsteinBasisMatrix<T>(num_cpts - 1, u);
+        Matrix<T> cpts = basis.transpose().partialPivLu().solve(
+                samples.middleCols(sample_idx, num_cpts).transpose()
+        ).transpose();
+
+        for(Eigen::Index j = 0; j < num_cpts; j++) {
+            for(unsigned int d = 0; d < DIM; d++) {
+                dvars(offset + j * DIM + d) = cpts(d, j);
+            }
+        }
+
+        offset += num_cpts * DIM;
+        sample_idx += num_cpts;
+    }
+
+    if(offset != dvars.rows()) {
+        return std::nullopt;
+    }
+
+    // the decision variables are laid out piece by piece, control point by
+    // control point. make sure qpgen reads them back the same way.
+    const PiecewiseCurve warm_curve = qpgen.extractCurve(dvars);
+    offset = 0;
+    for(std::size_t p = 0; p < warm_curve.numPieces(); p++) {
+        for(std::size_t j = 0; j < warm_curve[p].numControlPoints(); j++) {
+            for(unsigned int d = 0; d < DIM; d++) {
+                T expected = dvars(offset++);
+                if(std::abs(warm_curve[p][j](d) - expected)
+                        > 1e-9 * (1 + std::abs(expected))) {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+
+    return dvars;
+}
+
+// optional inputs of generate_optimization_problem. defaults generate all
+// constraints as hard constraints with svm obstacle hyperplanes, without a
+// workspace, without a deadline and without culling other robots.
+template<typename T, unsigned int DIM>
+struct OptimizationProblemOptions {
+    // constraint name to whether the constraint is soft and its weight if it
+    // is. all constraints are hard if nullptr.
+    const std::unordered_map<std::string, std::pair<bool, T>>*
+            soft_parameters = nullptr;
+    ObstacleConstraintGenerator obstacle_constraint_generator
+            = ObstacleConstraintGenerator::SVM;
+    QPSolverSelection solvers;
+    // svm solve durations are appended if not nullptr
+    SolverDurations<T>* solver_durations = nullptr;
+    // solvers and geometric temporaries come from the workspace if not
+    // nullptr
+    PlannerWorkspace<T>* workspace = nullptr;
+    // robot to robot hyperplanes precomputed by the caller, one per other
+    // robot, if not nullptr
+    const std::vector<std::optional<Hyperplane<T, DIM>>>*
+            precomputed_robot_hyperplanes = nullptr;
+    // other robots farther away than what this speed covers in the first
+    // piece are not avoided in the first piece
+    T robot_culling_speed = std::numeric_limits<T>::infinity();
+    Deadline deadline;
+};
+
 template<typename T, unsigned int DIM>
 void generate_optimization_problem(
     splx::PiecewiseCurveQPGenerator<T, DIM>& qpgen,
@@ -65,13 +335,37 @@ void generate_optimization_problem(
     const OccupancyGrid<T, DIM>& occupancy_grid,
     const StdVectorVectorDIM<T, DIM>& current_robot_state,
     MathematicaWriter<T, DIM>& mathematica,
-    const std::unordered_map<std::string, std::pair<bool, T>>& soft_parameters
-            = std::unordered_map<std::string, std::pair<bool, T>>()
+    const OptimizationProblemOptions<T, DIM>& options
+            = OptimizationProblemOptions<T, DIM>()
 ) {
     using VectorDIM = internal::VectorDIM<T, DIM>;
     using AlignedBox = internal::AlignedBox<T, DIM>;
     using Hyperplane = internal::Hyperplane<T, DIM>;
-    using StdVectorVectorDIM = internal::StdVectorVectorDIM<T, DIM>;
+    using PmrVectorVectorDIM = internal::PmrVectorVectorDIM<T, DIM>;
+
+    static const std::unordered_map<std::string, std::pair<bool, T>>
+            all_hard;
+    const std::unordered_map<std::string, std::pair<bool, T>>& soft_parameters
+            = options.soft_parameters != nullptr
+              ? *options.soft_parameters
+              : all_hard;
+
+    // geometric temporaries are allocated from the workspace arena if there
+    // is one
+    std::pmr::memory_resource* resource
+            = options.workspace != nullptr
+              ? &options.workspace->arena()
+              : std::pmr::get_default_resource();
+
+#ifdef ENABLE_RLSS_HP_REDUNDANCY_LP_FILTER
+    // one solver for the pruning LPs of all pieces
+    std::shared_ptr<QPSolver<T>> lp_solver
+            = options.workspace != nullptr
+              ? options.workspace->solver(
+                    options.solvers.lp, PlannerWorkspace<T>::LpSlot)
+              : std::shared_ptr<QPSolver<T>>(
+                    createQPSolver<T>(options.solvers.lp));
+#endif
 
     if(segments.size() != qpgen.numPieces() + 1) {
         throw std::domain_error(
@@ -159,16 +453,68 @@ void generate_optimization_problem(
     mathematica.selfCollisionBox(
             colshape->boundingBox(current_robot_state[0]));
 
-    // robot to robot avoidance constraints for the first piece
-    std::vector<Hyperplane> robot_to_robot_hps
+    // robot to robot avoidance constraints for the first piece. robots that
+    // can not reach the robot during the first piece are culled. hyperplanes
+    // precomputed by the caller, e.g. once per robot pair for a batch of
+    // robots, are used as is and the missing ones are computed.
+    if(options.precomputed_robot_hyperplanes != nullptr
+       && options.precomputed_robot_hyperplanes->size()
+          != oth_rbt_col_shape_bboxes.size()) {
+        throw std::domain_error(
+            absl::StrCat(
+                "number of precomputed robot to robot hyperplanes is not ",
+                "equal to the number of other robots, hyperplanes: ",
+                options.precomputed_robot_hyperplanes->size(),
+                ", other robots: ",
+                oth_rbt_col_shape_bboxes.size()
+            )
+        );
+    }
+
+    const AlignedBox robot_box
+            = colshape->boundingBox(current_robot_state[0]);
+    const T robot_culling_distance
+            = options.robot_culling_speed * durations[0];
+
+    std::vector<Hyperplane> robot_to_robot_hps;
+    std::vector<AlignedBox> robot_hyperplane_bboxes;
+    for(std::size_t i = 0; i < oth_rbt_col_shape_bboxes.size(); i++) {
+        if(robot_box.exteriorDistance(oth_rbt_col_shape_bboxes[i])
+                > robot_culling_distance) {
+            continue;
+        }
+
+        if(options.precomputed_robot_hyperplanes != nullptr
+           && (*options.precomputed_robot_hyperplanes)[i]) {
+            robot_to_robot_hps.push_back(
+                    *(*options.precomputed_robot_hyperplanes)[i]);
+        } else {
+            robot_hyperplane_bboxes.push_back(oth_rbt_col_shape_bboxes[i]);
+        }
+    }
+
+    std::vector<Hyperplane> computed_robot_to_robot_hps
             = robot_safety_hyperplanes<T, DIM>(
                     current_robot_state[0],
-                    oth_rbt_col_shape_bboxes,
-                    colshape
+                    robot_hyperplane_bboxes,
+                    colshape,
+                    options.solvers.svm,
+                    options.solver_durations,
+                    options.workspace,
+                    options.deadline
             );
+    robot_to_robot_hps.insert(
+            robot_to_robot_hps.end(),
+            computed_robot_to_robot_hps.begin(),
+            computed_robot_to_robot_hps.end());
 
-//    robot_to_robot_hps = internal::pruneHyperplanes<T, DIM>(
-//            robot_to_robot_hps, ws);
+    debug_message(
+        "robot to robot hyperplanes for ",
+        robot_to_robot_hps.size(),
+        " of ",
+        oth_rbt_col_shape_bboxes.size(),
+        " other robots"
+    );
 
     for(const auto& hp: robot_to_robot_hps) {
         bool r2r_hyperplane_constraints_soft_enabled
@@ -194,8 +540,6 @@ void generate_optimization_problem(
     }
 
 
-    assert(robot_to_robot_hps.size() == oth_rbt_col_shape_bboxes.size());
-
     for(const auto& hp: robot_to_robot_hps) {
         mathematica.robotCollisionAvoidanceHyperplane(hp);
         debug_message(
@@ -214,71 +558,129 @@ void generate_optimization_problem(
         p_idx < qpgen.numPieces();
         p_idx++
     ) {
+        options.deadline.throwIfExpired();
+
         AlignedBox from_box
                 = colshape->boundingBox(segments[p_idx]);
         AlignedBox to_box
                 = colshape->boundingBox(segments[p_idx+1]);
         to_box.extend(from_box);
 
-        StdVectorVectorDIM segments_corners
-                = rlss::internal::cornerPoints<T, DIM>(to_box);
-
         std::vector<Hyperplane> piece_obstacle_hyperplanes;
 
-        for(
-            auto it = occupancy_grid.begin(to_box, obstacle_check_distance);
-            it != occupancy_grid.end(to_box, obstacle_check_distance);
-            ++it
-        ) {
+        if(options.obstacle_constraint_generator
+                == ObstacleConstraintGenerator::SafeCorridor) {
+            AlignedBox corridor = rlss::internal::inflateFreeBox<T, DIM>(
+                    occupancy_grid,
+                    wss,
+                    to_box,
+                    obstacle_check_distance
+            );
 
-            AlignedBox grid_box = *it;
+            debug_message(
+                "piece ",
+                p_idx,
+                " safe corridor is [min: ",
+                corridor.min().transpose(),
+                ", max: ",
+                corridor.max().transpose(),
+                "]"
+            );
+
+            // like the svm generator, obstacles further than obstacle check
+            // distance are not considered
+            AlignedBox bounds(
+                    to_box.min().array() - obstacle_check_distance,
+                    to_box.max().array() + obstacle_check_distance
+            );
+            bounds = bounds.intersection(wss);
 
-            StdVectorVectorDIM grid_box_corners
-                    = rlss::internal::cornerPoints<T, DIM>(grid_box);
+            piece_obstacle_hyperplanes
+                = rlss::internal::corridorHyperplanes<T, DIM>(
+                        corridor,
+                        bounds,
+                        colshape
+            );
+        } else {
+            PmrVectorVectorDIM segments_corners(resource);
+            rlss::internal::cornerPoints<T, DIM>(to_box, segments_corners);
 
-            Hyperplane shp = rlss::internal::svm<T, DIM>
-                    (
-                            segments_corners,
-                            grid_box_corners
-                    );
+            PmrVectorVectorDIM grid_box_corners(resource);
+            for(
+                auto it = occupancy_grid.begin(to_box, obstacle_check_distance);
+                it != occupancy_grid.end(to_box, obstacle_check_distance);
+                ++it
+            ) {
 
+                options.deadline.throwIfExpired();
 
-            shp = rlss::internal::shiftHyperplane<T, DIM>(
-                    VectorDIM::Zero(),
-                    colshape->boundingBox(VectorDIM::Zero()),
-                    shp
-            );
+                AlignedBox grid_box = *it;
+
+                rlss::internal::cornerPoints<T, DIM>(
+                        grid_box, grid_box_corners);
 
+                Hyperplane shp = rlss::internal::svm<T, DIM>
+                        (
+                                segments_corners,
+                                grid_box_corners,
+                                options.solvers.svm,
+                                options.solver_durations,
+                                options.workspace
+                        );
 
-            mathematica.obstacleCollisionBox(grid_box);
 
-            piece_obstacle_hyperplanes.push_back(shp);
+                shp = rlss::internal::shiftHyperplane<T, DIM>(
+                        VectorDIM::Zero(),
+                        colshape->boundingBox(VectorDIM::Zero()),
+                        shp
+                );
+
+
+                mathematica.obstacleCollisionBox(grid_box);
+
+                piece_obstacle_hyperplanes.push_back(shp);
+            }
         }
 
+        bool r2o_hyperplane_constraints_soft_enabled
+            = soft_parameters.find(
+                    "robot_to_obstacle_hyperplane_constraints"
+              )
+              != soft_parameters.end()
+              && soft_parameters.at("robot_to_obstacle_hyperplane_constraints")
+                                    .first;
+
+        T r2o_hyperplane_constraints_soft_weight =
+            r2o_hyperplane_constraints_soft_enabled
+            ? soft_parameters.at("robot_to_obstacle_hyperplane_constraints")
+                        .second
+            : 0;
+
         debug_message("before prune num hyperplanes: "
                 , piece_obstacle_hyperplanes.size());
-//        piece_obstacle_hyperplanes
-//            = internal::pruneHyperplanes<T, DIM>(
-//                                piece_obstacle_hyperplanes,
-//                                ws
-//         );
+        // redundant hyperplanes do not change the feasible set of hard
+        // constraints, but their slack variables change the cost of soft
+        // ones.
+        if(!r2o_hyperplane_constraints_soft_enabled) {
+            piece_obstacle_hyperplanes
+                = internal::pruneDominatedHyperplanes<T, DIM>(
+                                    piece_obstacle_hyperplanes,
+                                    ws
+            );
+#ifdef ENABLE_RLSS_HP_REDUNDANCY_LP_FILTER
+            piece_obstacle_hyperplanes
+                = internal::pruneRedundantHyperplanes<T, DIM>(
+                                    piece_obstacle_hyperplanes,
+                                    ws,
+                                    options.solvers.lp,
+                                    lp_solver.get()
+            );
+#endif
+        }
         debug_message("after prune num hyperplanes: "
                 , piece_obstacle_hyperplanes.size());
 
         for(const auto& shp: piece_obstacle_hyperplanes) {
-            bool r2o_hyperplane_constraints_soft_enabled
-                = soft_parameters.find(
-                        "robot_to_obstacle_hyperplane_constraints"
-                  )
-                  != soft_parameters.end()
-                  && soft_parameters.at("robot_to_obstacle_hyperplane_constraints")
-                                        .first;
-
-            T r2o_hyperplane_constraints_soft_weight =
-                r2o_hyperplane_constraints_soft_enabled
-                ? soft_parameters.at("robot_to_obstacle_hyperplane_constraints")
-                            .second
-                : 0;
             qpgen.addHyperplaneConstraintForPiece(
                     p_idx,
                     shp,
@@ -359,12 +761,16 @@ void generate_optimization_problem(
 
 
     // energy cost
+#ifdef ENABLE_RLSS_CACHED_COST_HESSIANS
+    addIntegratedSquaredDerivativeCosts<T, DIM>(qpgen, lambdas);
+#else
     for(const auto& [d, l]: lambdas) {
         debug_message("adding integrated squared derivative cost for",
             "degree ", d, " with lambda ", l
         );
         qpgen.addIntegratedSquaredDerivativeCost(d, l);
     }
+#endif
 
 
 
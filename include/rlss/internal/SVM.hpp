@@ -4,8 +4,9 @@
 #include <Eigen/Geometry>
 #include <Eigen/StdVector>
 #include <qp_wrappers/problem.hpp>
-#include <qp_wrappers/cplex.hpp>
 #include <rlss/internal/Util.hpp>
+#include <rlss/internal/QPSolver.hpp>
+#include <rlss/internal/PlannerWorkspace.hpp>
 #include <absl/strings/str_cat.h>
 
 namespace rlss {
@@ -16,11 +17,21 @@ namespace internal {
 * Calculate the svm hyperplane between two set of points f and s
 * such that for all points p \in f, np + d < 0 where n is the normal
 * of the hyperplane and d is the offset of the hyperplane.
+*
+* The QP is solved with the QPSolverRegistry backend solver_name, and with
+* cplex if it fails. Durations of the solver calls are appended to
+* solver_durations if it is not nullptr. Solvers of workspace are used if it
+* is not nullptr.
 */
-template<typename T, unsigned int DIM>
+template<typename T, unsigned int DIM,
+         typename FPoints = StdVectorVectorDIM<T, DIM>,
+         typename SPoints = StdVectorVectorDIM<T, DIM>>
 Hyperplane<T, DIM> svm(
-    const StdVectorVectorDIM<T,DIM>& f, 
-    const StdVectorVectorDIM<T,DIM>& s) {
+    const FPoints& f,
+    const SPoints& s,
+    const std::string& solver_name = "qpoases",
+    SolverDurations<T>* solver_durations = nullptr,
+    PlannerWorkspace<T>* workspace = nullptr) {
 
     QPWrappers::Problem<T> svm_qp(DIM + 1);
     Matrix<T> Q(DIM+1, DIM+1);
@@ -55,10 +66,24 @@ Hyperplane<T, DIM> svm(
     }
 
 
-    QPWrappers::RLSS_SVM_QP_SOLVER::Engine<T> solver;
-    solver.setFeasibilityTolerance(1e-8);
+    auto solve = [&](const std::string& name, Vector<T>& result) {
+        std::shared_ptr<QPSolver<T>> solver
+                = workspace != nullptr
+                  ? workspace->solver(name, PlannerWorkspace<T>::SvmSlot)
+                  : std::shared_ptr<QPSolver<T>>(createQPSolver<T>(name));
+        solver->setFeasibilityTolerance(1e-8);
+        // svm solves are not limited to the deadline of the trajectory
+        // optimizers
+        solver->setTimeLimit(std::numeric_limits<T>::infinity());
+        auto ret = solver->init(svm_qp, result);
+        if(solver_durations != nullptr) {
+            solver_durations->emplace_back(name, solver->lastSolveDuration());
+        }
+        return ret;
+    };
+
     Vector<T> result(DIM+1);
-    auto ret = solver.init(svm_qp, result);
+    auto ret = solve(solver_name, result);
 //    debug_message("svm optimization return value is ", ret);
     Hyperplane<T, DIM> hp;
 
@@ -69,9 +94,10 @@ Hyperplane<T, DIM> svm(
         hp.offset() = result(DIM);
     } else {
         // cplex seems more reliable for svm
-        QPWrappers::CPLEX::Engine<T> solver;
-        solver.setFeasibilityTolerance(1e-8);
-        auto ret = solver.init(svm_qp, result);
+        if(solver_name != "cplex"
+           && QPSolverRegistry<T>::instance().contains("cplex")) {
+            ret = solve("cplex", result);
+        }
 //        debug_message("svm optimization CPLEX return value is ", ret);
         if(ret == QPWrappers::OptReturnType::Optimal) {
             for(unsigned int d = 0; d < DIM; d++) {
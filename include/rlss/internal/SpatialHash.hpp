@@ -0,0 +1,179 @@
+#ifndef RLSS_INTERNAL_SPATIAL_HASH_HPP
+#define RLSS_INTERNAL_SPATIAL_HASH_HPP
+
+#include <rlss/internal/Util.hpp>
+#include <boost/functional/hash/hash.hpp>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Boxes bucketed into the cells of a uniform grid, so that the boxes near
+ * a box are found without checking all boxes. Each box is stored in every
+ * cell it overlaps. Queries with distances up to the cell size touch at
+ * most 3^DIM cells per cell overlapped by the query box.
+ */
+template<typename T, unsigned int DIM>
+class SpatialHash {
+public:
+    using AlignedBox = internal::AlignedBox<T, DIM>;
+    using VectorDIM = internal::VectorDIM<T, DIM>;
+    using Index = internal::VectorDIM<long long int, DIM>;
+
+    explicit SpatialHash(T cell_size): m_cell_size(cell_size) {
+        if(!(cell_size > 0) || !std::isfinite(cell_size)) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "spatial hash cell size must be positive and finite, ",
+                    "given: ",
+                    cell_size
+                )
+            );
+        }
+    }
+
+    /*
+     * Removes all boxes and sets the cell size. Cells keep their storage if
+     * the cell size is the same, so that a hash refilled with boxes in the
+     * same cells does not allocate. Emptied cells are kept until the cell
+     * size changes.
+     */
+    void reset(T cell_size) {
+        if(cell_size == m_cell_size) {
+            for(auto& [idx, ids]: m_cells) {
+                ids.clear();
+            }
+        } else {
+            *this = SpatialHash(cell_size);
+        }
+        m_boxes.clear();
+    }
+
+    // adds box with the given id
+    void insert(std::size_t id, const AlignedBox& box) {
+        if(id >= m_boxes.size()) {
+            m_boxes.resize(id + 1);
+        }
+        m_boxes[id] = box;
+
+        Index min_idx = this->index(box.min());
+        Index max_idx = this->index(box.max());
+        this->forEachCell(min_idx, max_idx, [&](const Index& idx) {
+            m_cells[idx].push_back(id);
+        });
+    }
+
+    /*
+     * Sets ids to the sorted ids of the boxes whose distance to box is at
+     * most distance. distance must be finite.
+     */
+    void query(
+            const AlignedBox& box,
+            T distance,
+            std::vector<std::size_t>& ids
+    ) const {
+        ids.clear();
+
+        AlignedBox extended(
+                box.min().array() - distance,
+                box.max().array() + distance);
+        Index min_idx = this->index(extended.min());
+        Index max_idx = this->index(extended.max());
+
+        this->forEachCell(min_idx, max_idx, [&](const Index& idx) {
+            auto it = m_cells.find(idx);
+            if(it == m_cells.end()) {
+                return;
+            }
+            for(std::size_t id: it->second) {
+                if(box.exteriorDistance(m_boxes[id]) <= distance) {
+                    ids.push_back(id);
+                }
+            }
+        });
+
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    /*
+     * Whether there is a box whose distance to box is at most distance.
+     * distance must be finite.
+     */
+    bool anyWithin(const AlignedBox& box, T distance) const {
+        AlignedBox extended(
+                box.min().array() - distance,
+                box.max().array() + distance);
+        Index min_idx = this->index(extended.min());
+        Index max_idx = this->index(extended.max());
+
+        bool found = false;
+        this->forEachCell(min_idx, max_idx, [&](const Index& idx) {
+            if(found) {
+                return;
+            }
+            auto it = m_cells.find(idx);
+            if(it == m_cells.end()) {
+                return;
+            }
+            for(std::size_t id: it->second) {
+                if(box.exteriorDistance(m_boxes[id]) <= distance) {
+                    found = true;
+                    return;
+                }
+            }
+        });
+
+        return found;
+    }
+
+    T cellSize() const {
+        return m_cell_size;
+    }
+
+private:
+    T m_cell_size;
+    std::unordered_map<
+            Index,
+            std::vector<std::size_t>,
+            VectorDIMHasher<long long int, DIM>
+    > m_cells;
+    std::vector<AlignedBox> m_boxes;
+
+    Index index(const VectorDIM& pt) const {
+        Index idx;
+        for(unsigned int d = 0; d < DIM; d++) {
+            idx(d) = static_cast<long long int>(
+                    std::floor(pt(d) / m_cell_size));
+        }
+        return idx;
+    }
+
+    template<typename F>
+    void forEachCell(const Index& min_idx, const Index& max_idx, F f) const {
+        Index idx = min_idx;
+        while(true) {
+            f(idx);
+            unsigned int d = 0;
+            for(; d < DIM; d++) {
+                if(idx(d) < max_idx(d)) {
+                    idx(d)++;
+                    break;
+                }
+                idx(d) = min_idx(d);
+            }
+            if(d == DIM) {
+                break;
+            }
+        }
+    }
+}; // class SpatialHash
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_SPATIAL_HASH_HPP
@@ -2,8 +2,14 @@
 #define RLSS_STATISTICS_COLLECTOR_HPP
 
 #include <rlss/internal/Util.hpp>
+#include <rlss/internal/JSONLinesWriter.hpp>
 #include "../../../third_party/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <map>
+#include <memory>
 
 namespace rlss {
 
@@ -164,6 +170,136 @@ template<typename T, typename U>
     );
 }
 
+/*
+ * Log bucketed histogram of non-negative values in constant memory. Values
+ * in resolution * [2^e, 2^(e+1)) for e < MaxExponent are split into
+ * SubBuckets buckets of equal width, so percentiles are within
+ * 1 / (2 * SubBuckets) of the true value relatively. Values below
+ * resolution share the first bucket and values from
+ * resolution * 2^MaxExponent on share the last. For durations in
+ * microseconds with resolution 1, that covers 1us to 12 days. Min, max,
+ * mean and stddev are exact.
+ */
+template<typename T>
+class Histogram {
+public:
+    static constexpr unsigned int SubBuckets = 32;
+    static constexpr int MaxExponent = 40;
+    static constexpr std::size_t NumBuckets = 1 + MaxExponent * SubBuckets;
+
+    explicit Histogram(T resolution = 1)
+        : m_resolution(resolution),
+          m_counts(NumBuckets, 0),
+          m_stats(zeroStats<T, T>())
+    {
+
+    }
+
+    void add(T value) {
+        m_counts[bucketIndex(value / m_resolution)]++;
+        m_stats = combineStats<T, T>(
+                m_stats,
+                std::make_tuple(value, value, value, T(0), std::size_t(1))
+        );
+    }
+
+    // rhs must have the same resolution
+    Histogram& operator+=(const Histogram& rhs) {
+        if(rhs.m_resolution != m_resolution) {
+            throw std::domain_error(
+                absl::StrCat(
+                    "histograms of different resolutions can not be merged, ",
+                    m_resolution,
+                    " vs ",
+                    rhs.m_resolution
+                )
+            );
+        }
+        for(std::size_t i = 0; i < NumBuckets; i++) {
+            m_counts[i] += rhs.m_counts[i];
+        }
+        m_stats = combineStats<T, T>(m_stats, rhs.m_stats);
+        return *this;
+    }
+
+    std::size_t count() const {
+        return std::get<ipopsize>(m_stats);
+    }
+
+    const Stats<T, T>& stats() const {
+        return m_stats;
+    }
+
+    // value that fraction q of the values are at most, 0 if empty. Exact
+    // for q = 1.
+    T percentile(T q) const {
+        if(this->count() == 0) {
+            return 0;
+        }
+        const std::size_t rank = std::max(
+                std::size_t(1),
+                static_cast<std::size_t>(std::ceil(q * this->count())));
+        if(rank >= this->count()) {
+            return std::get<imax>(m_stats);
+        }
+        std::size_t cumulative = 0;
+        std::size_t i = 0;
+        for(; i + 1 < NumBuckets; i++) {
+            cumulative += m_counts[i];
+            if(cumulative >= rank) {
+                break;
+            }
+        }
+        return std::clamp(
+                bucketMidpoint(i) * m_resolution,
+                std::get<imin>(m_stats),
+                std::get<imax>(m_stats)
+        );
+    }
+
+private:
+    T m_resolution;
+    std::vector<std::uint64_t> m_counts;
+    Stats<T, T> m_stats;
+
+    static std::size_t bucketIndex(T value) {
+        if(!(value >= 1)) {
+            return 0;
+        }
+        int exponent;
+        // value = mantissa * 2^exponent, mantissa in [0.5, 1)
+        const T mantissa = std::frexp(value, &exponent);
+        const int e = exponent - 1;
+        if(e >= MaxExponent) {
+            return NumBuckets - 1;
+        }
+        const unsigned int sub = std::min(
+                static_cast<unsigned int>((2 * mantissa - 1) * SubBuckets),
+                SubBuckets - 1);
+        return 1 + static_cast<std::size_t>(e) * SubBuckets + sub;
+    }
+
+    static T bucketMidpoint(std::size_t i) {
+        if(i == 0) {
+            return T(0.5);
+        }
+        i--;
+        const int e = static_cast<int>(i / SubBuckets);
+        const std::size_t sub = i % SubBuckets;
+        return std::ldexp(1 + (sub + T(0.5)) / SubBuckets, e);
+    }
+}; // Histogram
+
+// stats of the histogram with its p50, p90, p99 and p999
+template<typename T>
+[[nodiscard]] nlohmann::json toJSON(const Histogram<T>& histogram) {
+    nlohmann::json result = toJSON(histogram.stats());
+    result["p50"] = histogram.percentile(T(0.5));
+    result["p90"] = histogram.percentile(T(0.9));
+    result["p99"] = histogram.percentile(T(0.99));
+    result["p999"] = histogram.percentile(T(0.999));
+    return result;
+}
 
 static long long int storage_file_count = 0;
 
@@ -209,6 +345,30 @@ public:
         m_bfs_durations.push_back(bd);
     }
 
+    // duration of a call to the qp backend with the given registry name
+    void addSolverDuration(const std::string& solver, T sd) {
+        m_solver_durations[solver].push_back(sd);
+    }
+
+    /*
+     * Clears the statistics in place for the next call. Vectors keep their
+     * storage and solver names are kept with empty durations, so that
+     * statistics reused across calls do not allocate once they have seen
+     * every solver.
+     */
+    void reset() {
+        m_goal_selection_duration = 0;
+        m_discrete_search_duration = 0;
+        m_trajectory_optimization_durations.clear();
+        m_validity_check_durations.clear();
+        m_planning_duration = 0;
+        m_svm_durations.clear();
+        m_bfs_durations.clear();
+        for(auto& [solver, durations]: m_solver_durations) {
+            durations.clear();
+        }
+    }
+
 
     T goalSelectionDuration() const {
         return m_goal_selection_duration;
@@ -238,6 +398,11 @@ public:
         return m_bfs_durations;
     }
 
+    // durations of solvers with no calls since the last reset are empty
+    const std::map<std::string, std::vector<T>>& solverDurations() const {
+        return m_solver_durations;
+    }
+
     statistics::Stats<T, T>
     goalSelectionStatistics() const {
         std::vector<T> data {m_goal_selection_duration};
@@ -277,6 +442,17 @@ public:
         return statistics::createStats<T, T>(m_bfs_durations);
     }
 
+    std::map<std::string, statistics::Stats<T, T>>
+    solverDurationsStatistics() const {
+        std::map<std::string, statistics::Stats<T, T>> result;
+        for(const auto& [solver, durations]: m_solver_durations) {
+            if(!durations.empty()) {
+                result[solver] = statistics::createStats<T, T>(durations);
+            }
+        }
+        return result;
+    }
+
     nlohmann::json toJSON() const {
         nlohmann::json result;
         result["goal_selection_duration"] = m_goal_selection_duration;
@@ -294,20 +470,26 @@ public:
         for(const auto& r: m_bfs_durations) {
             result["bfs_durations"].push_back(r);
         }
+        for(const auto& [solver, durations]: m_solver_durations) {
+            if(!durations.empty()) {
+                result["solver_durations"][solver] = durations;
+            }
+        }
 
         return result;
     }
 
 
 private:
-    T m_goal_selection_duration;
-    T m_discrete_search_duration;
+    T m_goal_selection_duration = 0;
+    T m_discrete_search_duration = 0;
     std::vector<T> m_trajectory_optimization_durations;
     std::vector<T> m_validity_check_durations;
-    T m_planning_duration;
+    T m_planning_duration = 0;
 
     std::vector<T> m_svm_durations;
     std::vector<T> m_bfs_durations;
+    std::map<std::string, std::vector<T>> m_solver_durations;
 }; // DurationStatistics
 
 
@@ -333,6 +515,20 @@ public:
     void addSVMSuccessFail(bool r) {
         m_svm_success_fail.push_back(r);
     }
+    void setDeadlineHit(bool r) {
+        m_deadline_hit = r;
+    }
+
+    // clears the statistics in place for the next call, vectors keep their
+    // storage
+    void reset() {
+        m_goal_selection_success_fail = false;
+        m_discrete_search_success_fail = false;
+        m_trajectory_optimization_success_fail.clear();
+        m_planning_success_fail = false;
+        m_svm_success_fail.clear();
+        m_deadline_hit = false;
+    }
 
     bool goalSelectionSuccessFail() const {
         return m_goal_selection_success_fail;
@@ -354,6 +550,11 @@ public:
         return m_svm_success_fail;
     }
 
+    // whether planning stopped because its deadline expired
+    bool deadlineHit() const {
+        return m_deadline_hit;
+    }
+
     // returns [num successes, num failures]
     std::pair<unsigned int, unsigned int>
             trajectoryOptimizationStatistics() const {
@@ -398,6 +599,7 @@ public:
         result["goal_selection_success_fail"] = m_goal_selection_success_fail;
         result["discrete_search_success_fail"] = m_discrete_search_success_fail;
         result["planning_success_fail"] = m_planning_success_fail;
+        result["deadline_hit"] = m_deadline_hit;
         for(bool r: m_trajectory_optimization_success_fail) {
             result["trajectory_optimization_success_fail"].push_back(r);
         }
@@ -409,11 +611,12 @@ public:
     }
 
 private:
-    bool m_goal_selection_success_fail;
-    bool m_discrete_search_success_fail;
+    bool m_goal_selection_success_fail = false;
+    bool m_discrete_search_success_fail = false;
     std::vector<bool> m_trajectory_optimization_success_fail;
-    bool m_planning_success_fail;
+    bool m_planning_success_fail = false;
     std::vector<bool> m_svm_success_fail;
+    bool m_deadline_hit = false;
 
 }; // SuccessFailureStatistics
 
@@ -426,6 +629,7 @@ class StatisticsStorage {
 public:
     using DurationStatistics_ = DurationStatistics<T>;
     using SuccessFailureStatistics_ = SuccessFailureStatistics<T>;
+    using Histogram = statistics::Histogram<T>;
 
     StatisticsStorage() {
 
@@ -434,149 +638,168 @@ public:
     ~StatisticsStorage() {
     }
 
+    /*
+     * Whether the statistics of each call are kept in addition to the
+     * duration histograms and the success failure counters. Kept records
+     * are written by save, but their memory grows with the number of calls,
+     * so they are not kept by default. Summaries are computed from the
+     * histograms and counters either way.
+     */
+    void setKeepRecords(bool keep) {
+        m_keep_records = keep;
+    }
+
+    /*
+     * Also appends the statistics of each call to writer as they are
+     * added, tagged with source. Records are streamed whether or not they
+     * are kept.
+     */
+    void streamTo(std::shared_ptr<JSONLinesWriter> writer, std::size_t source) {
+        m_writer = std::move(writer);
+        m_source = source;
+    }
+
     void add(const DurationStatistics_& ds) {
-        m_durations_statistics.push_back(ds);
+        m_duration_histograms.goal_selection.add(ds.goalSelectionDuration());
+        m_duration_histograms.discrete_search.add(
+                ds.discreteSearchDuration());
+        for(T duration: ds.trajectoryOptimizationDurations()) {
+            m_duration_histograms.trajectory_optimization.add(duration);
+        }
+        for(T duration: ds.validityCheckDurations()) {
+            m_duration_histograms.validity_check.add(duration);
+        }
+        m_duration_histograms.planning.add(ds.planningDuration());
+        for(T duration: ds.svmDurations()) {
+            m_duration_histograms.svm.add(duration);
+        }
+        for(T duration: ds.bfsDurations()) {
+            m_duration_histograms.bfs.add(duration);
+        }
+        for(const auto& [solver, durations]: ds.solverDurations()) {
+            if(durations.empty()) {
+                continue;
+            }
+            Histogram& histogram = m_duration_histograms.solvers[solver];
+            for(T duration: durations) {
+                histogram.add(duration);
+            }
+        }
+
+        if(m_keep_records) {
+            m_durations_statistics.push_back(ds);
+        }
+        // records are built only when streamed, so that adding statistics
+        // does not allocate otherwise
+        if(m_writer) {
+            this->stream("duration_statistics", ds.toJSON());
+        }
     }
 
     void add(const SuccessFailureStatistics_& sf) {
-        m_sf_statistics.push_back(sf);
+        m_success_failure_counts.add(sf);
+        if(m_keep_records) {
+            m_sf_statistics.push_back(sf);
+        }
+        if(m_writer) {
+            this->stream("success_failure_statistics", sf.toJSON());
+        }
     }
 
+    // per call duration statistics, empty if records are not kept
     const std::vector<DurationStatistics_>& durationStatistics() const {
         return m_durations_statistics;
     }
 
+    // per call success failure statistics, empty if records are not kept
     const std::vector<SuccessFailureStatistics_>& sfStatistics() const {
         return m_sf_statistics;
     }
 
-    nlohmann::json durationSummaryJSON() const {
-        using Stats = statistics::Stats<T, T>;
-        Stats goal_selection_stats
-            = statistics::zeroStats<T, T>();
-        Stats discrete_search_stats
-            = statistics::zeroStats<T, T>();
-        Stats trajectory_optimization_stats
-            = statistics::zeroStats<T, T>();
-        Stats validity_check_stats
-            = statistics::zeroStats<T, T>();
-        Stats planning_stats
-            = statistics::zeroStats<T, T>();
-        Stats svm_stats
-            = statistics::zeroStats<T, T>();
-        Stats bfs_stats
-            = statistics::zeroStats<T, T>();
-
-        for(const DurationStatistics_& ds: m_durations_statistics) {
-            goal_selection_stats = statistics::combineStats<T, T>(
-                    goal_selection_stats, ds.goalSelectionStatistics());
-            discrete_search_stats = statistics::combineStats<T, T>(
-                    discrete_search_stats, ds.discreteSearchStatistics());
-            trajectory_optimization_stats = statistics::combineStats<T, T>(
-                    trajectory_optimization_stats,
-                    ds.trajectoryOptimizationDurationsStatistics());
-            validity_check_stats = statistics::combineStats<T, T>(
-                    validity_check_stats,
-                    ds.validityCheckDurationsStatistics());
-            planning_stats = statistics::combineStats<T, T>(
-                    planning_stats, ds.planningStatistics());
-            svm_stats = statistics::combineStats<T, T>(
-                    svm_stats, ds.svmDurationsStatistics());
-            bfs_stats = statistics::combineStats<T, T>(
-                    bfs_stats, ds.bfsDurationsStatistics());
+    // age in seconds of the trajectory robot follows, recorded once per
+    // period
+    void addPlanAge(std::size_t robot, T age) {
+        this->planAgeHistogram(robot).add(age);
+        if(m_writer) {
+            nlohmann::json record;
+            record["robot"] = robot;
+            record["age"] = age;
+            this->stream("plan_age", record);
         }
+    }
 
+    const std::map<std::size_t, Histogram>& planAges() const {
+        return m_plan_ages;
+    }
 
+    nlohmann::json planAgeSummaryJSON() const {
         nlohmann::json summary;
-        summary["goal_selection"] = statistics::toJSON(goal_selection_stats);
-        summary["discrete_search"] = statistics::toJSON(discrete_search_stats);
-        summary["trajectory_optimization"] = statistics::toJSON(trajectory_optimization_stats);
-        summary["validity_check"] = statistics::toJSON(validity_check_stats);
-        summary["planning"] = statistics::toJSON(planning_stats);
-        summary["svm"] = statistics::toJSON(svm_stats);
-        summary["bfs"] = statistics::toJSON(bfs_stats);
-
+        for(const auto& [robot, ages]: m_plan_ages) {
+            summary[std::to_string(robot)] = statistics::toJSON(ages);
+        }
         return summary;
     }
 
-    nlohmann::json successFailureSummaryJSON() const {
-        /*
-         *     bool m_goal_selection_success_fail;
-    bool m_discrete_search_success_fail;
-    std::vector<bool> m_trajectory_optimization_success_fail;
-    bool m_planning_success_fail;
-    std::vector<bool> m_svm_success_fail;
-         */
-        std::pair<unsigned int, unsigned int> goal_selection
-                = std::make_pair(0, 0);
-        std::pair<unsigned int, unsigned int> discrete_search
-                = std::make_pair(0, 0);
-        std::pair<unsigned int, unsigned int> traj_opt
-                = std::make_pair(0, 0);
-        std::pair<unsigned int, unsigned int> planning
-                = std::make_pair(0, 0);
-        std::pair<unsigned int, unsigned int> svm
-                = std::make_pair(0, 0);
-
-        // how many times trajectory optimization is retried
-        std::vector<std::size_t> num_traj_opt_when_planning_successful;
-
-        for(const SuccessFailureStatistics_& sf: m_sf_statistics) {
-            if(sf.goalSelectionSuccessFail()) {
-                goal_selection.first++;
-            } else {
-                goal_selection.second++;
-            }
-
-            if(sf.discreteSearchSuccessFail()) {
-                discrete_search.first++;
-            } else {
-                discrete_search.second++;
-            }
-
-            auto tr = sf.trajectoryOptimizationStatistics();
-            traj_opt.first += tr.first;
-            traj_opt.second += tr.second;
-
-            if(sf.planningSuccessFail()) {
-                planning.first++;
-                num_traj_opt_when_planning_successful.push_back(
-                        sf.trajectoryOptimizationSuccessFail().size());
-            } else {
-                planning.second++;
-            }
-
-            auto sv = sf.svmStatistics();
-            svm.first += sv.first;
-            svm.second += sv.second;
-
+    nlohmann::json durationSummaryJSON() const {
+        nlohmann::json summary;
+        summary["goal_selection"]
+            = statistics::toJSON(m_duration_histograms.goal_selection);
+        summary["discrete_search"]
+            = statistics::toJSON(m_duration_histograms.discrete_search);
+        summary["trajectory_optimization"]
+            = statistics::toJSON(m_duration_histograms.trajectory_optimization);
+        summary["validity_check"]
+            = statistics::toJSON(m_duration_histograms.validity_check);
+        summary["planning"]
+            = statistics::toJSON(m_duration_histograms.planning);
+        summary["svm"] = statistics::toJSON(m_duration_histograms.svm);
+        summary["bfs"] = statistics::toJSON(m_duration_histograms.bfs);
+        for(const auto& [solver, histogram]: m_duration_histograms.solvers) {
+            summary["solvers"][solver] = statistics::toJSON(histogram);
         }
 
-        statistics::Stats<T, T> num_traj_opt_stats
-            = statistics::createStats<std::size_t, T>(
-                    num_traj_opt_when_planning_successful);
+        return summary;
+    }
 
+    nlohmann::json successFailureSummaryJSON() const {
+        const SuccessFailureCounts& counts = m_success_failure_counts;
         nlohmann::json result;
 
-        result["goal_selection"]["success"] = goal_selection.first;
-        result["goal_selection"]["fail"] = goal_selection.second;
-        result["discrete_search"]["success"] = discrete_search.first;
-        result["discrete_search"]["fail"] = discrete_search.second;
-        result["trajectory_optimization"]["success"] = traj_opt.first;
-        result["trajectory_optimization"]["fail"] = traj_opt.second;
+        result["goal_selection"]["success"] = counts.goal_selection.first;
+        result["goal_selection"]["fail"] = counts.goal_selection.second;
+        result["discrete_search"]["success"] = counts.discrete_search.first;
+        result["discrete_search"]["fail"] = counts.discrete_search.second;
+        result["trajectory_optimization"]["success"]
+            = counts.trajectory_optimization.first;
+        result["trajectory_optimization"]["fail"]
+            = counts.trajectory_optimization.second;
         result["trajectory_optimization"]
               ["retry_count_when_planning_successful"]
-            = statistics::toJSON(num_traj_opt_stats);
-        result["planning"]["success"] = planning.first;
-        result["planning"]["fail"] = planning.second;
-        result["svm"]["success"] = svm.first;
-        result["svm"]["fail"] = svm.second;
+            = statistics::toJSON(
+                    counts.trajectory_optimization_count_when_successful);
+        result["planning"]["success"] = counts.planning.first;
+        result["planning"]["fail"] = counts.planning.second;
+        result["planning"]["deadline_hit"] = counts.deadline_hit;
+        result["svm"]["success"] = counts.svm.first;
+        result["svm"]["fail"] = counts.svm.second;
 
         return result;
     }
 
+    // summaries save writes next to the records
+    nlohmann::json summaryJSON() const {
+        nlohmann::json summary;
+        summary["duration_summary"] = this->durationSummaryJSON();
+        summary["success_failure_summary"]
+            = this->successFailureSummaryJSON();
+        if(!m_plan_ages.empty()) {
+            summary["plan_age_summary"] = this->planAgeSummaryJSON();
+        }
+        return summary;
+    }
+
     void save(const std::string& filename) const {
-        nlohmann::json stats;
+        nlohmann::json stats = this->summaryJSON();
         for(const auto& ds: m_durations_statistics) {
             stats["duration_statistics"].push_back(ds.toJSON());
         }
@@ -585,9 +808,6 @@ public:
             stats["success_failure_statistics"].push_back(sfs.toJSON());
         }
 
-        stats["duration_summary"] = this->durationSummaryJSON();
-        stats["success_failure_summary"] = this->successFailureSummaryJSON();
-
         std::ofstream file(filename, std::ios_base::out);
         file << stats.dump();
         file.close();
@@ -601,14 +821,21 @@ public:
     }
 
     StatisticsStorage<T>& operator+=(const StatisticsStorage<T>& rhs) {
-        m_durations_statistics.insert(
-                m_durations_statistics.end(),
-                rhs.m_durations_statistics.begin(),
-                rhs.m_durations_statistics.end());
-        m_sf_statistics.insert(
-                m_sf_statistics.end(),
-                rhs.m_sf_statistics.begin(),
-                rhs.m_sf_statistics.end());
+        if(m_keep_records) {
+            m_durations_statistics.insert(
+                    m_durations_statistics.end(),
+                    rhs.m_durations_statistics.begin(),
+                    rhs.m_durations_statistics.end());
+            m_sf_statistics.insert(
+                    m_sf_statistics.end(),
+                    rhs.m_sf_statistics.begin(),
+                    rhs.m_sf_statistics.end());
+        }
+        m_success_failure_counts += rhs.m_success_failure_counts;
+        for(const auto& [robot, ages]: rhs.m_plan_ages) {
+            this->planAgeHistogram(robot) += ages;
+        }
+        m_duration_histograms += rhs.m_duration_histograms;
 
         return *this;
 
@@ -617,6 +844,110 @@ public:
 private:
     std::vector<DurationStatistics_> m_durations_statistics;
     std::vector<SuccessFailureStatistics_> m_sf_statistics;
+    std::map<std::size_t, Histogram> m_plan_ages;
+
+    bool m_keep_records = false;
+
+    std::shared_ptr<JSONLinesWriter> m_writer;
+    std::size_t m_source = 0;
+
+    void stream(const std::string& type, nlohmann::json record) const {
+        if(m_writer) {
+            record["type"] = type;
+            record["source"] = m_source;
+            m_writer->write(std::move(record));
+        }
+    }
+
+    // plan ages are recorded in milliseconds resolution
+    Histogram& planAgeHistogram(std::size_t robot) {
+        auto it = m_plan_ages.find(robot);
+        if(it == m_plan_ages.end()) {
+            it = m_plan_ages.emplace(robot, Histogram(T(1e-3))).first;
+        }
+        return it->second;
+    }
+
+    // [num successes, num failures] of each stage over all calls
+    struct SuccessFailureCounts {
+        using Counts = std::pair<std::size_t, std::size_t>;
+
+        Counts goal_selection{0, 0};
+        Counts discrete_search{0, 0};
+        Counts trajectory_optimization{0, 0};
+        Counts planning{0, 0};
+        Counts svm{0, 0};
+        std::size_t deadline_hit = 0;
+        // how many times trajectory optimization is tried in successful
+        // calls
+        Histogram trajectory_optimization_count_when_successful;
+
+        static void count(Counts& counts, bool success) {
+            if(success) {
+                counts.first++;
+            } else {
+                counts.second++;
+            }
+        }
+
+        static void count(Counts& counts, const Counts& successes_failures) {
+            counts.first += successes_failures.first;
+            counts.second += successes_failures.second;
+        }
+
+        void add(const SuccessFailureStatistics_& sf) {
+            count(goal_selection, sf.goalSelectionSuccessFail());
+            count(discrete_search, sf.discreteSearchSuccessFail());
+            count(trajectory_optimization,
+                  sf.trajectoryOptimizationStatistics());
+            count(planning, sf.planningSuccessFail());
+            count(svm, sf.svmStatistics());
+            if(sf.planningSuccessFail()) {
+                trajectory_optimization_count_when_successful.add(
+                        sf.trajectoryOptimizationSuccessFail().size());
+            }
+            if(sf.deadlineHit()) {
+                deadline_hit++;
+            }
+        }
+
+        SuccessFailureCounts& operator+=(const SuccessFailureCounts& rhs) {
+            count(goal_selection, rhs.goal_selection);
+            count(discrete_search, rhs.discrete_search);
+            count(trajectory_optimization, rhs.trajectory_optimization);
+            count(planning, rhs.planning);
+            count(svm, rhs.svm);
+            deadline_hit += rhs.deadline_hit;
+            trajectory_optimization_count_when_successful
+                += rhs.trajectory_optimization_count_when_successful;
+            return *this;
+        }
+    } m_success_failure_counts;
+
+    struct DurationHistograms {
+        Histogram goal_selection;
+        Histogram discrete_search;
+        Histogram trajectory_optimization;
+        Histogram validity_check;
+        Histogram planning;
+        Histogram svm;
+        Histogram bfs;
+        std::map<std::string, Histogram> solvers;
+
+        DurationHistograms& operator+=(const DurationHistograms& rhs) {
+            goal_selection += rhs.goal_selection;
+            discrete_search += rhs.discrete_search;
+            trajectory_optimization += rhs.trajectory_optimization;
+            validity_check += rhs.validity_check;
+            planning += rhs.planning;
+            svm += rhs.svm;
+            bfs += rhs.bfs;
+            for(const auto& [solver, histogram]: rhs.solvers) {
+                solvers[solver] += histogram;
+            }
+            return *this;
+        }
+    } m_duration_histograms;
 };
 
 #else
@@ -652,6 +983,12 @@ public:
     void addBFSDuration(T bd) {
     }
 
+    void addSolverDuration(const std::string& solver, T sd) {
+    }
+
+    void reset() {
+    }
+
     nlohmann::json toJSON() const {
         return nlohmann::json();
     }
@@ -728,6 +1065,10 @@ public:
     }
     void addSVMSuccessFail(bool r) {
     }
+    void setDeadlineHit(bool r) {
+    }
+    void reset() {
+    }
 
     nlohmann::json toJSON() const {
         return nlohmann::json();
@@ -753,6 +1094,10 @@ public:
         return {};
     }
 
+    bool deadlineHit() const {
+        return false;
+    }
+
     // returns [num successes, num failures]
     std::tuple<unsigned int, unsigned int>
     trajectoryOptimizationStatistics() const {
@@ -799,6 +1144,19 @@ public:
         return {};
     }
 
+    void addPlanAge(std::size_t robot, T age) {
+    }
+
+    void setKeepRecords(bool keep) {
+    }
+
+    void streamTo(std::shared_ptr<JSONLinesWriter> writer, std::size_t source) {
+    }
+
+    nlohmann::json summaryJSON() const {
+        return nlohmann::json();
+    }
+
     void save(const std::string& filename) {
     }
 
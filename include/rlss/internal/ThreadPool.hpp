@@ -0,0 +1,183 @@
+#ifndef RLSS_INTERNAL_THREAD_POOL_HPP
+#define RLSS_INTERNAL_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Fixed set of worker threads that run the iterations of parallelFor.
+ * Threads are created once and reused, so that a loop that runs every
+ * simulation step does not pay for thread creation on each step.
+ * parallelFor is called by one thread at a time.
+ */
+class ThreadPool {
+public:
+    // thread_count = 0 uses one thread per hardware thread
+    explicit ThreadPool(std::size_t thread_count = 0) {
+        if(thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // the calling thread of parallelFor works as well
+        for(std::size_t i = 1; i < thread_count; i++) {
+            m_workers.emplace_back([this]() { this->workerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_job_available.notify_all();
+        for(std::thread& worker: m_workers) {
+            worker.join();
+        }
+    }
+
+    // number of threads that run iterations including the calling thread
+    std::size_t threadCount() const {
+        return m_workers.size() + 1;
+    }
+
+    /*
+     * Calls fn(i) for i in [0, count) and returns once all calls are done.
+     * Iterations are distributed dynamically, so fn must only write to
+     * state owned by iteration i. The first exception thrown by an
+     * iteration is rethrown after all iterations are done.
+     */
+    void parallelFor(
+            std::size_t count,
+            const std::function<void(std::size_t)>& fn
+    ) {
+        if(count == 0) {
+            return;
+        }
+
+        if(m_workers.empty() || count == 1) {
+            for(std::size_t i = 0; i < count; i++) {
+                fn(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &fn;
+            m_job_count = count;
+            m_next_index = 0;
+            m_remaining = count;
+            m_exception = nullptr;
+            m_generation++;
+        }
+        m_job_available.notify_all();
+
+        this->runIterations();
+
+        // workers still inside the job could otherwise touch the next one
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_job_done.wait(lock, [this]() {
+            return m_remaining == 0 && m_active_workers == 0;
+        });
+        m_job = nullptr;
+
+        if(m_exception) {
+            std::exception_ptr exception = m_exception;
+            m_exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_job_available;
+    std::condition_variable m_job_done;
+
+    const std::function<void(std::size_t)>* m_job = nullptr;
+    std::size_t m_job_count = 0;
+    std::atomic<std::size_t> m_next_index{0};
+    std::size_t m_remaining = 0;
+    // number of workers that picked up the current job and are not done
+    std::size_t m_active_workers = 0;
+    std::exception_ptr m_exception;
+    // incremented for each job so that workers run each job once
+    std::size_t m_generation = 0;
+    bool m_stopping = false;
+
+    void workerLoop() {
+        std::size_t seen_generation = 0;
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_job_available.wait(lock, [&]() {
+                    return m_stopping
+                           || (m_job != nullptr
+                               && m_generation != seen_generation);
+                });
+                if(m_stopping) {
+                    return;
+                }
+                seen_generation = m_generation;
+                m_active_workers++;
+            }
+            this->runIterations();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_active_workers--;
+            }
+            m_job_done.notify_all();
+        }
+    }
+
+    void runIterations() {
+        std::size_t done = 0;
+        std::exception_ptr exception;
+        while(true) {
+            std::size_t i = m_next_index.fetch_add(1);
+            if(i >= m_job_count) {
+                break;
+            }
+            try {
+                (*m_job)(i);
+            } catch(...) {
+                if(!exception) {
+                    exception = std::current_exception();
+                }
+            }
+            done++;
+        }
+
+        if(done == 0) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(exception && !m_exception) {
+                m_exception = exception;
+            }
+            m_remaining -= done;
+        }
+        m_job_done.notify_all();
+    }
+}; // class ThreadPool
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_THREAD_POOL_HPP
@@ -0,0 +1,64 @@
+#ifndef RLSS_INTERNAL_UNIQUE_ID_HPP
+#define RLSS_INTERNAL_UNIQUE_ID_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace rlss {
+namespace internal {
+
+/*
+ * Identifier drawn from a process wide counter, so that no two objects ever
+ * get the same value, even if one is destroyed and another is constructed
+ * at the same address. Copies and moves draw new values, and moving also
+ * renews the value of the source since its contents change. Caches keyed
+ * on the identifier of an object can not mistake a later state of any
+ * object for the one they were built from.
+ */
+class UniqueId {
+public:
+    UniqueId(): m_value(next()) {
+
+    }
+
+    UniqueId(const UniqueId&): m_value(next()) {
+
+    }
+
+    UniqueId(UniqueId&& other) noexcept: m_value(next()) {
+        other.renew();
+    }
+
+    UniqueId& operator=(const UniqueId&) {
+        this->renew();
+        return *this;
+    }
+
+    UniqueId& operator=(UniqueId&& other) noexcept {
+        this->renew();
+        other.renew();
+        return *this;
+    }
+
+    // draws a new value, e.g. after the identified object changes
+    void renew() {
+        m_value = next();
+    }
+
+    std::uint64_t value() const {
+        return m_value;
+    }
+
+private:
+    static std::uint64_t next() {
+        static std::atomic<std::uint64_t> counter(0);
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::uint64_t m_value;
+}; // class UniqueId
+
+} // namespace internal
+} // namespace rlss
+
+#endif // RLSS_INTERNAL_UNIQUE_ID_HPP
@@ -11,18 +11,8 @@
 #include <absl/strings/str_cat.h>
 #include <iostream>
 #include <fstream>
-#include <qp_wrappers/cplex.hpp>
-#include <qp_wrappers/gurobi.hpp>
-#include <qp_wrappers/qpoases.hpp>
-#include <qp_wrappers/osqp.hpp>
 #include <splx/curve/PiecewiseCurve.hpp>
-#include <lp_wrappers/cplex.hpp>
-#include <lp_wrappers/gurobi.hpp>
-
-#define RLSS_HARD_QP_SOLVER CPLEX
-#define RLSS_SOFT_QP_SOLVER CPLEX
-#define RLSS_SVM_QP_SOLVER qpOASES
-#define RLSS_HP_PRUNING_LP_SOLVER GUROBI
+#include <rlss/internal/QPSolver.hpp>
 
 namespace rlss {
 
@@ -94,14 +84,22 @@ using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
 template<typename T, unsigned int R, unsigned int C>
 using MatrixRC = Eigen::Matrix<T, R, C>; // row column
 
-template<typename T, unsigned int DIM>
-StdVectorVectorDIM<T, DIM> cornerPoints(const AlignedBox<T, DIM>& box) {
-    StdVectorVectorDIM<T, DIM> pts(1<<DIM);
+// writes the corner points of box to pts, which can be any vector of
+// VectorDIM such as a PmrVectorVectorDIM
+template<typename T, unsigned int DIM, typename Container>
+void cornerPoints(const AlignedBox<T, DIM>& box, Container& pts) {
+    pts.resize(1<<DIM);
     for(unsigned int i = 0; i < (1<<DIM); i++) {
         for(unsigned int d = 0; d < DIM; d++) {
             pts[i](d) = (i & (1<<d)) ? box.min()(d) : box.max()(d);
         }
     }
+}
+
+template<typename T, unsigned int DIM>
+StdVectorVectorDIM<T, DIM> cornerPoints(const AlignedBox<T, DIM>& box) {
+    StdVectorVectorDIM<T, DIM> pts;
+    cornerPoints<T, DIM>(box, pts);
     return pts;
 }
 
@@ -118,14 +116,14 @@ public:
 };
 
 
-template <typename T, unsigned int DIM>
-StdVectorVectorDIM<T, DIM> linearInterpolate(
+// appends num_points points evenly spaced from start to end to result
+template <typename T, unsigned int DIM, typename Container>
+void appendLinearInterpolation(
     const VectorDIM<T, DIM>& start,
     const VectorDIM<T, DIM>& end,
-    std::size_t num_points
+    std::size_t num_points,
+    Container& result
 ) {
-
-    using StdVectorVectorDIM = StdVectorVectorDIM<T, DIM>;
     using VectorDIM = VectorDIM<T, DIM>;
 
     if(num_points < 2) {
@@ -139,25 +137,45 @@ StdVectorVectorDIM<T, DIM> linearInterpolate(
         );
     }
 
-    StdVectorVectorDIM result(num_points);
-
     VectorDIM step_vec = (end - start) / (num_points - 1);
 
-    result[0] = start;
+    result.push_back(start);
     for(std::size_t step = 1; step < num_points - 1; step++) {
-        result[step] = start + step * step_vec;
+        result.push_back(start + step * step_vec);
     }
-    result.back() = end;
-
-    return result;
-
+    result.push_back(end);
+}
 
+// writes num_points points evenly spaced from start to end to result
+template <typename T, unsigned int DIM, typename Container>
+void linearInterpolate(
+    const VectorDIM<T, DIM>& start,
+    const VectorDIM<T, DIM>& end,
+    std::size_t num_points,
+    Container& result
+) {
+    result.clear();
+    appendLinearInterpolation<T, DIM>(start, end, num_points, result);
 }
 
 template <typename T, unsigned int DIM>
-StdVectorVectorDIM<T, DIM> bestSplitSegments(
+StdVectorVectorDIM<T, DIM> linearInterpolate(
+    const VectorDIM<T, DIM>& start,
+    const VectorDIM<T, DIM>& end,
+    std::size_t num_points
+) {
+    StdVectorVectorDIM<T, DIM> result;
+    linearInterpolate<T, DIM>(start, end, num_points, result);
+    return result;
+}
+
+// writes segments split into num_pieces pieces to result. the longest
+// pieces are split first. result must not be segments.
+template <typename T, unsigned int DIM, typename Container>
+void bestSplitSegments(
     const StdVectorVectorDIM<T, DIM>& segments,
-    std::size_t num_pieces
+    std::size_t num_pieces,
+    Container& result
 ) {
     if(num_pieces + 1 < segments.size()) {
         throw std::domain_error(
@@ -173,10 +191,12 @@ StdVectorVectorDIM<T, DIM> bestSplitSegments(
 
 
     using VectorDIM = VectorDIM<T, DIM>;
-    using StdVectorVectorDIM = StdVectorVectorDIM<T, DIM>;
+
+    result.clear();
 
     if(segments.size() == 1) {
-        return StdVectorVectorDIM(num_pieces + 1, segments[0]);
+        result.resize(num_pieces + 1, segments[0]);
+        return;
     }
 
     struct SegmentPQElem {
@@ -234,35 +254,53 @@ StdVectorVectorDIM<T, DIM> bestSplitSegments(
             }
     );
 
-    StdVectorVectorDIM result;
-
     for(const SegmentPQElem& pqelem: segment_pqelems) {
-        StdVectorVectorDIM interpolate
-            = linearInterpolate<T, DIM>(
-                    pqelem.start,
-                    pqelem.end,
-                    pqelem.num_pieces + 1
+        appendLinearInterpolation<T, DIM>(
+                pqelem.start,
+                pqelem.end,
+                pqelem.num_pieces + 1,
+                result
         );
-
-        result.insert(result.end(), interpolate.begin(), interpolate.end() - 1);
+        // end of the piece is the start of the next one
+        result.pop_back();
     }
 
     result.push_back(segments.back());
-    return  result;
 }
 
-template<typename T, unsigned int DIM>
-StdVectorVectorDIM<T, DIM> firstSegmentFix(
-    const StdVectorVectorDIM<T, DIM>& segments
+template <typename T, unsigned int DIM>
+StdVectorVectorDIM<T, DIM> bestSplitSegments(
+    const StdVectorVectorDIM<T, DIM>& segments,
+    std::size_t num_pieces
+) {
+    StdVectorVectorDIM<T, DIM> result;
+    bestSplitSegments<T, DIM>(segments, num_pieces, result);
+    return result;
+}
+
+// writes segments with the first segment split in half to result. result
+// must not be segments.
+template<typename T, unsigned int DIM, typename Container>
+void firstSegmentFix(
+    const StdVectorVectorDIM<T, DIM>& segments,
+    Container& result
 ) {
     assert(segments.size() > 1);
 
-    StdVectorVectorDIM<T, DIM> result;
+    result.clear();
     result.push_back(segments[0]);
     result.push_back((segments[0] + segments[1]) / 2);
     for(std::size_t i = 1; i < segments.size(); i++) {
         result.push_back(segments[i]);
     }
+}
+
+template<typename T, unsigned int DIM>
+StdVectorVectorDIM<T, DIM> firstSegmentFix(
+    const StdVectorVectorDIM<T, DIM>& segments
+) {
+    StdVectorVectorDIM<T, DIM> result;
+    firstSegmentFix<T, DIM>(segments, result);
     return result;
 }
 // shift hyperplane hp creating hyperplane shp
@@ -279,13 +317,14 @@ Hyperplane<T, DIM> shiftHyperplane(
     const Hyperplane<T, DIM>& hp
 ) {
     using Hyperplane = Hyperplane<T, DIM>;
-    using StdVectorVectorDIM = StdVectorVectorDIM<T, DIM>;
     Hyperplane shp {hp.normal(), std::numeric_limits<T>::lowest()};
 
-
-    StdVectorVectorDIM corner_points = cornerPoints<T, DIM>(box);
-
-    for(const auto& pt : corner_points) {
+    // corner points of box
+    for(unsigned int i = 0; i < (1<<DIM); i++) {
+        VectorDIM<T, DIM> pt;
+        for(unsigned int d = 0; d < DIM; d++) {
+            pt(d) = (i & (1<<d)) ? box.min()(d) : box.max()(d);
+        }
         shp.offset()
                 = std::max(shp.offset(),
                            hp.normal().dot(pt - center_of_mass) + hp.offset()
@@ -311,61 +350,210 @@ AlignedBox<T, DIM> bufferAlignedBox(
 }
 
 /*
- * Prunes hyperplanes h in hps such that if the space S bounded by the bounding
- * box bbox and the hyperplane h contains the space S' bounded by the bounding
- * box bbox and an hyperplane h' in hps (that is S' is a subset of S).
+ * Maximum of hp.normal().dot(x) + hp.offset() for x in the bounding box bbox.
  */
 template<typename T, unsigned int DIM>
-std::vector<Hyperplane<T, DIM>> pruneHyperplanes(
-        const std::vector<Hyperplane<T,DIM>>& hps,
+T maxSignedValueInBox(
+        const VectorDIM<T, DIM>& normal,
+        T offset,
         const AlignedBox<T, DIM>& bbox) {
+    T result = offset;
+    for(unsigned int d = 0; d < DIM; d++) {
+        result += normal(d) * (normal(d) > 0 ? bbox.max()(d) : bbox.min()(d));
+    }
+    return result;
+}
 
+/*
+ * Removes hyperplanes in hps that are redundant for the set of points x in
+ * the bounding box bbox satisfying hp.normal().dot(x) + hp.offset() <= 0
+ * for all hp in hps, using closed form tests only:
+ *  - hyperplanes that are satisfied everywhere in bbox are removed.
+ *  - hyperplane h' is removed if there is a remaining hyperplane h such that
+ *    for all x in bbox, h'(x) <= h(x) after normalizing both, i.e. h
+ *    implies h' in bbox. this removes duplicate and near-parallel
+ *    hyperplanes that are looser than another one in bbox.
+ *
+ * The order of the remaining hyperplanes is preserved.
+ */
+template<typename T, unsigned int DIM>
+std::vector<Hyperplane<T, DIM>> pruneDominatedHyperplanes(
+        const std::vector<Hyperplane<T, DIM>>& hps,
+        const AlignedBox<T, DIM>& bbox) {
     using Hyperplane = Hyperplane<T, DIM>;
-    using AlignedBox = AlignedBox<T, DIM>;
-    using LP = LPWrappers::Problem<T>;
-    using LPEngine = LPWrappers::RLSS_HP_PRUNING_LP_SOLVER::Engine<T>;
-    using Vector = typename LPEngine::Vector;
+    using VectorDIM = VectorDIM<T, DIM>;
 
-    std::vector<Hyperplane> result = hps;
-    LP lp(DIM, 2);
-    LPEngine solver;
+    std::vector<VectorDIM> normals;
+    std::vector<T> offsets;
+    std::vector<bool> removed(hps.size(), false);
+    normals.reserve(hps.size());
+    offsets.reserve(hps.size());
+
+    for(std::size_t i = 0; i < hps.size(); i++) {
+        T norm = hps[i].normal().norm();
+        if(norm == 0) {
+            removed[i] = hps[i].offset() <= 0;
+            normals.push_back(VectorDIM::Zero());
+            offsets.push_back(hps[i].offset());
+            continue;
+        }
+        normals.push_back(hps[i].normal() / norm);
+        offsets.push_back(hps[i].offset() / norm);
+        removed[i] = maxSignedValueInBox<T, DIM>(
+                normals[i], offsets[i], bbox) <= 0;
+    }
 
-    for(unsigned int d = 0; d < DIM; d++) {
-        lp.set_var_limits(d, bbox.min()(d), bbox.max()(d));
+    for(std::size_t i = 0; i < hps.size(); i++) {
+        if(removed[i] || normals[i].isZero()) {
+            continue;
+        }
+        for(std::size_t j = 0; j < hps.size(); j++) {
+            if(i == j || removed[j] || normals[j].isZero()) {
+                continue;
+            }
+            if(maxSignedValueInBox<T, DIM>(
+                    normals[j] - normals[i],
+                    offsets[j] - offsets[i],
+                    bbox) <= 0) {
+                removed[j] = true;
+            }
+        }
+    }
+
+    std::vector<Hyperplane> result;
+    for(std::size_t i = 0; i < hps.size(); i++) {
+        if(!removed[i]) {
+            result.push_back(hps[i]);
+        }
     }
+    return result;
+}
 
-    Vector c(DIM);
-    for(unsigned int d = 0; d < DIM; d++) c(d) = 1;
-    lp.add_c(c);
+/*
+ * Removes all hyperplanes in hps that are redundant for the set P of points
+ * x in the bounding box bbox satisfying hp.normal().dot(x) + hp.offset() <= 0
+ * for all hp in hps.
+ *
+ * Clarkson's algorithm: the hyperplanes known to be irredundant are
+ * collected in R. hyperplane h is redundant if max h(x) over bbox and R
+ * is non-positive. otherwise, the ray from an interior point of P to the
+ * maximizer hits an irredundant hyperplane first, which is added to R and
+ * h is tested again. each LP only contains the hyperplanes in R.
+ *
+ * Hyperplanes are kept whenever an LP is not solved to optimality, and hps
+ * is returned as is if P has no interior. All LPs are solved with solver
+ * if it is not nullptr, and with one solver of the QPSolverRegistry
+ * backend lp_solver created for the call otherwise.
+ */
+template<typename T, unsigned int DIM>
+std::vector<Hyperplane<T, DIM>> pruneRedundantHyperplanes(
+        const std::vector<Hyperplane<T, DIM>>& hps,
+        const AlignedBox<T, DIM>& bbox,
+        const std::string& lp_solver = "qpoases",
+        QPSolver<T>* solver = nullptr) {
+    using Hyperplane = Hyperplane<T, DIM>;
+    using VectorDIM = VectorDIM<T, DIM>;
+    using LP = QPWrappers::Problem<T>;
+    using Vector = typename LP::Vector;
 
-    for(std::size_t i = 0; i < result.size(); i++) {
-        bool should_remove_i = false;
+    if(hps.empty()) {
+        return hps;
+    }
+
+    std::unique_ptr<QPSolver<T>> created_solver;
+    if(solver == nullptr) {
+        created_solver = createQPSolver<T>(lp_solver);
+        solver = created_solver.get();
+    }
 
-        lp.set_constraint(1, result[i].normal().transpose(),
-                result[i].offset(), LP::infinity);
+    // interior point: maximize s subject to h(x) + s * |n_h| <= 0
+    VectorDIM interior;
+    {
+        LP lp(DIM + 1);
+        for(unsigned int d = 0; d < DIM; d++) {
+            lp.set_var_limits(d, bbox.min()(d), bbox.max()(d));
+        }
+        lp.set_var_limits(DIM, 0, 1);
+        for(const Hyperplane& hp: hps) {
+            Row<T> coeff(DIM + 1);
+            coeff << hp.normal().transpose(), hp.normal().norm();
+            lp.add_constraint(
+                    coeff, std::numeric_limits<T>::lowest(), -hp.offset());
+        }
+        Vector c = Vector::Zero(DIM + 1);
+        c(DIM) = -1;
+        lp.add_c(c);
+
+        Vector soln;
+        if(solver->init(lp, soln) != QPWrappers::OptReturnType::Optimal
+           || soln(DIM) <= 0) {
+            return hps;
+        }
+        interior = soln.head(DIM);
+    }
 
-        for(std::size_t j = 0; j < result.size(); j++) {
-            if(i == j) continue;
+    std::vector<bool> in_r(hps.size(), false);
+    std::vector<bool> processed(hps.size(), false);
+    std::vector<std::size_t> r_indices;
 
-            lp.set_constraint(0, result[j].normal().transpose(),
-                    LP::minus_infinity, result[j].offset());
+    for(std::size_t i = 0; i < hps.size(); i++) {
+        while(!processed[i]) {
+            LP lp(DIM);
+            for(unsigned int d = 0; d < DIM; d++) {
+                lp.set_var_limits(d, bbox.min()(d), bbox.max()(d));
+            }
+            for(std::size_t r: r_indices) {
+                lp.add_constraint(
+                        hps[r].normal().transpose(),
+                        std::numeric_limits<T>::lowest(),
+                        -hps[r].offset()
+                );
+            }
+            lp.add_c(-hps[i].normal());
 
             Vector soln;
-            auto ret = solver.init(lp, soln);
-            if(ret != LPWrappers::OptReturnType::Optimal) {
-                should_remove_i = true;
+            if(solver->init(lp, soln) != QPWrappers::OptReturnType::Optimal) {
+                in_r[i] = processed[i] = true;
+                r_indices.push_back(i);
                 break;
             }
-        }
 
-        if(should_remove_i) {
-            std::swap(result[i], result.back());
-            result.pop_back();
-            i--;
+            // keep weakly redundant hyperplanes instead of removing them
+            // based on the solver tolerance
+            VectorDIM maximizer = soln.head(DIM);
+            if(hps[i].signedDistance(maximizer)
+                    <= -1e-9 * hps[i].normal().norm()) {
+                processed[i] = true;
+                break;
+            }
+
+            // first hyperplane hit by the ray from interior to maximizer
+            VectorDIM direction = maximizer - interior;
+            std::size_t hit = i;
+            T hit_t = std::numeric_limits<T>::max();
+            for(std::size_t j = 0; j < hps.size(); j++) {
+                T rate = hps[j].normal().dot(direction);
+                if(in_r[j] || rate <= 0) {
+                    continue;
+                }
+                T t = -hps[j].signedDistance(interior) / rate;
+                if(t < hit_t) {
+                    hit_t = t;
+                    hit = j;
+                }
+            }
+
+            in_r[hit] = processed[hit] = true;
+            r_indices.push_back(hit);
         }
     }
 
-
+    std::vector<Hyperplane> result;
+    for(std::size_t i = 0; i < hps.size(); i++) {
+        if(in_r[i]) {
+            result.push_back(hps[i]);
+        }
+    }
     return result;
 }
 
@@ -0,0 +1,269 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/AsyncRLSS.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace {
+
+constexpr unsigned int DIM = 2U;
+using VectorDIM = rlss::internal::VectorDIM<double, DIM>;
+using StdVectorVectorDIM = rlss::internal::StdVectorVectorDIM<double, DIM>;
+using AlignedBox = rlss::internal::AlignedBox<double, DIM>;
+using OccupancyGrid = rlss::OccupancyGrid<double, DIM>;
+using PiecewiseCurve = splx::PiecewiseCurve<double, DIM>;
+using Bezier = splx::Bezier<double, DIM>;
+using RLSS = rlss::RLSS<double, DIM>;
+using AsyncRLSS = rlss::AsyncRLSS<double, DIM>;
+
+PiecewiseCurve line(const VectorDIM& from, const VectorDIM& to, double d) {
+    Bezier bezier(d);
+    bezier.appendControlPoint(from);
+    bezier.appendControlPoint(to);
+    PiecewiseCurve curve;
+    curve.addPiece(bezier);
+    return curve;
+}
+
+class FixedGoalSelector: public rlss::GoalSelector<double, DIM> {
+public:
+    std::optional<std::pair<VectorDIM, double>> select(
+            const VectorDIM& current_position,
+            const OccupancyGrid& occupancy_grid,
+            double current_time) override {
+        return std::make_pair(VectorDIM(1, 0), 1.0);
+    }
+};
+
+class StraightSearcher: public rlss::DiscretePathSearcher<double, DIM> {
+public:
+    std::optional<std::pair<StdVectorVectorDIM, std::vector<double>>> search(
+            const VectorDIM& start,
+            const VectorDIM& goal,
+            double time_horizon,
+            const OccupancyGrid& occupancy_grid) override {
+        return std::make_pair(
+                StdVectorVectorDIM{start, goal},
+                std::vector<double>{time_horizon});
+    }
+};
+
+// optimizes once gate is ready. counts the optimize calls in calls if it
+// is not nullptr.
+class GatedOptimizer: public rlss::TrajectoryOptimizer<double, DIM> {
+public:
+    explicit GatedOptimizer(
+            std::shared_future<void> gate,
+            std::atomic<int>* calls = nullptr)
+        : m_gate(gate),
+          m_calls(calls)
+    {
+
+    }
+
+    std::optional<PiecewiseCurve> optimize(
+            const StdVectorVectorDIM& segments,
+            const std::vector<double>& durations,
+            const std::vector<AlignedBox>& oth_rbt_col_shape_bboxes,
+            const OccupancyGrid& occupancy_grid,
+            const StdVectorVectorDIM& current_robot_state) override {
+        if(m_calls != nullptr) {
+            (*m_calls)++;
+        }
+        m_gate.wait();
+        return line(segments[0], segments[1], durations[0]);
+    }
+
+    std::shared_ptr<rlss::TrajectoryOptimizer<double, DIM>>
+            clone() const override {
+        return std::make_shared<GatedOptimizer>(m_gate, m_calls);
+    }
+
+private:
+    std::shared_future<void> m_gate;
+    std::atomic<int>* m_calls;
+};
+
+class AlwaysValid: public rlss::ValidityChecker<double, DIM> {
+public:
+    bool isValid(const PiecewiseCurve& curve) override {
+        return true;
+    }
+
+    std::shared_ptr<rlss::ValidityChecker<double, DIM>>
+            clone() const override {
+        return std::make_shared<AlwaysValid>();
+    }
+};
+
+class NeverValid: public rlss::ValidityChecker<double, DIM> {
+public:
+    bool isValid(const PiecewiseCurve& curve) override {
+        return false;
+    }
+
+    std::shared_ptr<rlss::ValidityChecker<double, DIM>>
+            clone() const override {
+        return std::make_shared<NeverValid>();
+    }
+};
+
+} // namespace
+
+TEST_CASE("predicted state of a trajectory", "[AsyncRLSS]") {
+    PiecewiseCurve curve = line(VectorDIM(0, 0), VectorDIM(2, 4), 2);
+
+    StdVectorVectorDIM state = AsyncRLSS::predictState(curve, 1, 2);
+    REQUIRE(state.size() == 2);
+    REQUIRE((state[0] - VectorDIM(1, 2)).norm() < 1e-9);
+    REQUIRE((state[1] - VectorDIM(1, 2)).norm() < 1e-9);
+
+    StdVectorVectorDIM end_state = AsyncRLSS::predictState(curve, 5, 1);
+    REQUIRE((end_state[0] - VectorDIM(2, 4)).norm() < 1e-9);
+}
+
+TEST_CASE("asynchronous planning and stale results", "[AsyncRLSS]") {
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+
+    auto planner = std::make_shared<RLSS>(
+            std::make_shared<FixedGoalSelector>(),
+            std::make_shared<GatedOptimizer>(gate_future),
+            std::make_shared<StraightSearcher>(),
+            std::make_shared<AlwaysValid>(),
+            1,
+            1.5
+    );
+    AsyncRLSS async_planner(planner);
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    StdVectorVectorDIM predicted_state{VectorDIM(0, 0)};
+
+    auto first = async_planner.planAsync(1, predicted_state, {}, grid);
+
+    // planAsync returns while planning waits for the gate
+    REQUIRE(first.wait_for(std::chrono::milliseconds(0))
+            == std::future_status::timeout);
+    gate.set_value();
+
+    const AsyncRLSS::Result& first_result = first.get();
+    REQUIRE(first_result.planning_result.status
+            == rlss::PlanningStatus::Success);
+    REQUIRE(first_result.start_time == 1);
+    REQUIRE(!async_planner.isStale(first_result, 0.5));
+    REQUIRE(!async_planner.isStale(first_result, 1));
+    REQUIRE(async_planner.isStale(first_result, 1.5));
+
+    auto second = async_planner.planAsync(2, predicted_state, {}, grid);
+    REQUIRE(async_planner.isStale(first_result, 0.5));
+    REQUIRE(!async_planner.isStale(second.get(), 2));
+
+    async_planner.invalidate();
+    REQUIRE(async_planner.isStale(second.get(), 2));
+}
+
+TEST_CASE("plannings do not keep earlier plannings alive", "[AsyncRLSS]") {
+    std::promise<void> gate;
+    gate.set_value();
+
+    auto planner = std::make_shared<RLSS>(
+            std::make_shared<FixedGoalSelector>(),
+            std::make_shared<GatedOptimizer>(gate.get_future().share()),
+            std::make_shared<StraightSearcher>(),
+            std::make_shared<AlwaysValid>(),
+            1,
+            1.5
+    );
+    AsyncRLSS async_planner(planner);
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    StdVectorVectorDIM predicted_state{VectorDIM(0, 0)};
+
+    for(int i = 0; i < 10; i++) {
+        async_planner.planAsync(i, predicted_state, {}, grid);
+    }
+    async_planner.wait();
+
+    // each planning holds the planner until its shared state is destroyed.
+    // only the last one is alive, next to this test and async_planner.
+    REQUIRE(planner.use_count() == 3);
+}
+
+TEST_CASE("deadline results carry only validated curves", "[AsyncRLSS]") {
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+
+    // the optimized curve is never valid and is optimized after the
+    // deadline expires
+    auto planner = std::make_shared<RLSS>(
+            std::make_shared<FixedGoalSelector>(),
+            std::make_shared<GatedOptimizer>(gate_future),
+            std::make_shared<StraightSearcher>(),
+            std::make_shared<NeverValid>(),
+            3,
+            1.5
+    );
+    AsyncRLSS async_planner(planner);
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    StdVectorVectorDIM predicted_state{VectorDIM(0, 0)};
+
+    const auto deadline = AsyncRLSS::Deadline::after(
+            std::chrono::milliseconds(10));
+    auto result = async_planner.planAsync(
+            1, predicted_state, {}, grid, deadline);
+    while(!deadline.expired()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    gate.set_value();
+
+    const AsyncRLSS::Result& planned = result.get();
+    REQUIRE(planned.planning_result.status
+            == rlss::PlanningStatus::DeadlineReusePrevious);
+    REQUIRE(!planned.planning_result.curve);
+}
+
+TEST_CASE("superseded plannings do not plan", "[AsyncRLSS]") {
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+    std::atomic<int> calls(0);
+
+    auto planner = std::make_shared<RLSS>(
+            std::make_shared<FixedGoalSelector>(),
+            std::make_shared<GatedOptimizer>(gate_future, &calls),
+            std::make_shared<StraightSearcher>(),
+            std::make_shared<AlwaysValid>(),
+            1,
+            1.5
+    );
+    AsyncRLSS async_planner(planner);
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    StdVectorVectorDIM predicted_state{VectorDIM(0, 0)};
+
+    auto first = async_planner.planAsync(1, predicted_state, {}, grid);
+    while(calls == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // requested while the first one plans. the second one is superseded by
+    // the third, and the third one by the invalidation.
+    auto second = async_planner.planAsync(2, predicted_state, {}, grid);
+    auto third = async_planner.planAsync(3, predicted_state, {}, grid);
+    async_planner.invalidate();
+    auto fourth = async_planner.planAsync(4, predicted_state, {}, grid);
+    gate.set_value();
+
+    REQUIRE(first.get().planning_result.status
+            == rlss::PlanningStatus::Success);
+    for(auto* superseded: {&second, &third}) {
+        const AsyncRLSS::Result& result = superseded->get();
+        REQUIRE(result.planning_result.status
+                == rlss::PlanningStatus::Superseded);
+        REQUIRE(!result.planning_result.curve);
+        REQUIRE(async_planner.isStale(result, 0));
+    }
+    REQUIRE(fourth.get().planning_result.status
+            == rlss::PlanningStatus::Success);
+    REQUIRE(calls == 2);
+}
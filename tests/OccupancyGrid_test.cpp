@@ -51,4 +51,164 @@ TEST_CASE("OccupancyGrid.getCenter() test", "OccupancyGrid") {
 
     center = grid.getCenter(Coordinate(122.3, 12.7, 11));
     REQUIRE((center - Coordinate(122.25, 12.6, 10.85)).squaredNorm() < 1e-9);
-}
\ No newline at end of file
+}
+TEST_CASE("OccupancyGrid cells id and temporary obstacles test", "OccupancyGrid") {
+    using OG = rlss::OccupancyGrid<double, 2>;
+    using Index = OG::Index;
+    using Coordinate = OG::Coordinate;
+    using AlignedBox = OG::AlignedBox;
+
+    OG grid(Coordinate(0.5, 0.5));
+    const std::uint64_t empty_id = grid.cellsId();
+
+    grid.setOccupancy(Index(1, 1));
+    const std::uint64_t occupied_id = grid.cellsId();
+    REQUIRE(occupied_id != empty_id);
+    grid.setOccupancy(Index(1, 1));
+    REQUIRE(grid.cellsId() == occupied_id);
+
+    grid.addTemporaryObstacle(
+            AlignedBox(Coordinate(2, 2), Coordinate(2.2, 2.2)));
+    REQUIRE(grid.cellsId() == occupied_id);
+
+    AlignedBox box(Coordinate(1.9, 1.9), Coordinate(2.1, 2.1));
+    REQUIRE(grid.isOccupied(box));
+    REQUIRE(grid.isOccupiedByTemporaryObstacles(box));
+    REQUIRE(!grid.isOccupiedIgnoringTemporaryObstacles(box));
+
+    // the same cells as before get a new id
+    grid.removeOccupancy(Index(1, 1));
+    const std::uint64_t removed_id = grid.cellsId();
+    REQUIRE(removed_id != empty_id);
+    REQUIRE(removed_id != occupied_id);
+    grid.removeOccupancy(Index(1, 1));
+    REQUIRE(grid.cellsId() == removed_id);
+
+    // ids are not reused by other grids, even at the same address
+    std::uint64_t previous_id = 0;
+    for(int i = 0; i < 3; i++) {
+        OG other(Coordinate(0.5, 0.5));
+        REQUIRE(other.cellsId() != removed_id);
+        REQUIRE(other.cellsId() != previous_id);
+        previous_id = other.cellsId();
+    }
+
+    OG copy(grid);
+    REQUIRE(copy.cellsId() != grid.cellsId());
+    REQUIRE(grid.cellsId() == removed_id);
+    OG moved(std::move(copy));
+    REQUIRE(moved.cellsId() != removed_id);
+    REQUIRE(copy.cellsId() != moved.cellsId());
+}
+
+TEST_CASE("OccupancyGrid overlay test", "OccupancyGrid") {
+    using OG = rlss::OccupancyGrid<double, 2>;
+    using Index = OG::Index;
+    using Coordinate = OG::Coordinate;
+    using AlignedBox = OG::AlignedBox;
+
+    OG grid(Coordinate(0.5, 0.5));
+    grid.setOccupancy(Index(1, 1));
+    grid.addTemporaryObstacle(
+            AlignedBox(Coordinate(5, 5), Coordinate(5.2, 5.2)));
+
+    AlignedBox dynamic_obstacle(Coordinate(2, 2), Coordinate(2.2, 2.2));
+    const OG overlay = OG::overlay(grid, {dynamic_obstacle});
+
+    REQUIRE(overlay.isOverlay());
+    REQUIRE(&overlay.getIndexSet() == &grid.getIndexSet());
+    REQUIRE(overlay.cellsId() == grid.cellsId());
+    REQUIRE(overlay.isOccupied(Index(1, 1)));
+    REQUIRE(overlay.isOccupiedByTemporaryObstacles(dynamic_obstacle));
+    REQUIRE(overlay.isOccupiedByTemporaryObstacles(
+            AlignedBox(Coordinate(5.1, 5.1), Coordinate(5.3, 5.3))));
+    REQUIRE(!grid.isOccupiedByTemporaryObstacles(dynamic_obstacle));
+    std::size_t obstacle_count = 0;
+    for(const AlignedBox& obstacle: overlay) {
+        obstacle_count++;
+    }
+    REQUIRE(obstacle_count == 3);
+
+    // overlays of overlays read the cells of the original grid
+    const OG nested = OG::overlay(overlay, {});
+    REQUIRE(&nested.getIndexSet() == &grid.getIndexSet());
+    REQUIRE(nested.isOccupiedByTemporaryObstacles(dynamic_obstacle));
+
+    grid.setOccupancy(Index(3, 3));
+    REQUIRE(overlay.isOccupied(Index(3, 3)));
+    REQUIRE(overlay.cellsId() == grid.cellsId());
+
+    OG mutable_overlay = OG::overlay(grid, {});
+    REQUIRE_THROWS_AS(mutable_overlay.setOccupancy(Index(0, 0)),
+                      std::domain_error);
+    REQUIRE_THROWS_AS(mutable_overlay.removeOccupancy(Index(1, 1)),
+                      std::domain_error);
+    REQUIRE(grid.isOccupied(Index(1, 1)));
+}
+
+TEST_CASE("OccupancyGrid indexed overlay test", "OccupancyGrid") {
+    using OG = rlss::OccupancyGrid<double, 2>;
+    using Index = OG::Index;
+    using Coordinate = OG::Coordinate;
+    using AlignedBox = OG::AlignedBox;
+
+    OG grid(Coordinate(0.5, 0.5));
+    grid.setOccupancy(Index(1, 1));
+    grid.setOccupancy(Index(4, 2));
+
+    // overlays index their temporary obstacles, the plain grid with the
+    // same temporary obstacles checks them linearly
+    std::vector<AlignedBox> obstacles;
+    for(int i = 0; i < 10; i++) {
+        for(int j = 0; j < 10; j++) {
+            Coordinate min(i * 1.3, j * 0.9);
+            obstacles.emplace_back(
+                    min, min + Coordinate(0.2 + 0.1 * i, 0.3));
+        }
+    }
+    obstacles.emplace_back(Coordinate(-20, -20), Coordinate(-5, -5));
+
+    const OG overlay = OG::overlay(grid, obstacles);
+    OG linear = grid;
+    for(const AlignedBox& obstacle: obstacles) {
+        linear.addTemporaryObstacle(obstacle);
+    }
+
+    for(long long int x = -30; x < 30; x++) {
+        for(long long int y = -30; y < 30; y++) {
+            REQUIRE(overlay.isOccupied(Index(x, y))
+                    == linear.isOccupied(Index(x, y)));
+
+            AlignedBox box = overlay.toBox(Index(x, y));
+            box.max() += Coordinate(0.3, 0.1);
+            REQUIRE(overlay.isOccupiedByTemporaryObstacles(box)
+                    == linear.isOccupiedByTemporaryObstacles(box));
+
+            for(double distance: {0.0, 0.4, 2.5}) {
+                std::vector<AlignedBox> indexed_near, linear_near;
+                for(auto it = overlay.begin(box, distance);
+                    it != overlay.end(box, distance); ++it) {
+                    indexed_near.push_back(*it);
+                }
+                for(auto it = linear.begin(box, distance);
+                    it != linear.end(box, distance); ++it) {
+                    linear_near.push_back(*it);
+                }
+                REQUIRE(indexed_near.size() == linear_near.size());
+                for(std::size_t i = 0; i < indexed_near.size(); i++) {
+                    REQUIRE(indexed_near[i].isApprox(linear_near[i]));
+                }
+            }
+        }
+    }
+
+    // temporary obstacles added to an overlay are indexed as well
+    OG mutable_overlay = OG::overlay(grid, obstacles);
+    AlignedBox added(Coordinate(50, 50), Coordinate(51, 51));
+    REQUIRE(!mutable_overlay.isOccupiedByTemporaryObstacles(added));
+    mutable_overlay.addTemporaryObstacle(added);
+    REQUIRE(mutable_overlay.isOccupiedByTemporaryObstacles(added));
+    mutable_overlay.clearTemporaryObstacles();
+    REQUIRE(!mutable_overlay.isOccupiedByTemporaryObstacles(added));
+    REQUIRE(!mutable_overlay.isOccupiedByTemporaryObstacles(obstacles[0]));
+}
@@ -0,0 +1,202 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/TrajectoryOptimizers/RLSSHardSoftOptimizer.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+constexpr unsigned int DIM = 2U;
+using VectorDIM = rlss::internal::VectorDIM<double, DIM>;
+using StdVectorVectorDIM = rlss::internal::StdVectorVectorDIM<double, DIM>;
+using AlignedBox = rlss::internal::AlignedBox<double, DIM>;
+using OccupancyGrid = rlss::OccupancyGrid<double, DIM>;
+using Optimizer = rlss::RLSSHardSoftOptimizer<double, DIM>;
+using QPGenerator = splx::PiecewiseCurveQPGenerator<double, DIM>;
+
+// returns what solve returns with a zero solution
+class FunctionSolver: public rlss::internal::QPSolver<double> {
+public:
+    using Base = rlss::internal::QPSolver<double>;
+
+    FunctionSolver(
+            const std::string& name,
+            std::function<OptReturnType()> solve)
+        : Base(name),
+          m_solve(std::move(solve))
+    {
+
+    }
+
+    void setFeasibilityTolerance(double tolerance) override {
+
+    }
+
+protected:
+    OptReturnType initImpl(const Problem& problem, Vector& soln) override {
+        soln = Vector::Zero(problem.num_vars());
+        return m_solve();
+    }
+
+    OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) override {
+        return this->initImpl(problem, soln);
+    }
+
+private:
+    std::function<OptReturnType()> m_solve;
+};
+
+void registerFunctionSolver(
+        const std::string& name,
+        std::function<QPWrappers::OptReturnType()> solve) {
+    rlss::internal::QPSolverRegistry<double>::instance().registerSolver(
+        name,
+        [name, solve]() {
+            return std::unique_ptr<rlss::internal::QPSolver<double>>(
+                    new FunctionSolver(name, solve));
+        }
+    );
+}
+
+// counts the solves that started and finished. solves wait until the gate
+// is opened. waits time out after 10 seconds, so that a broken optimizer
+// fails the test instead of blocking it.
+class Gate {
+public:
+    QPWrappers::OptReturnType solve() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_started++;
+        m_changed.notify_all();
+        m_changed.wait_for(
+                lock, std::chrono::seconds(10), [this]() { return m_open; });
+        m_finished++;
+        m_changed.notify_all();
+        return QPWrappers::OptReturnType::Optimal;
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_changed.notify_all();
+    }
+
+    // waits until at least count solves started
+    bool waitStarted(int count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(
+                lock,
+                std::chrono::seconds(10),
+                [this, count]() { return m_started >= count; });
+    }
+
+    int started() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_started;
+    }
+
+    int finished() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_finished;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_open = false;
+    int m_started = 0;
+    int m_finished = 0;
+};
+
+Optimizer optimizer(const rlss::QPSolverSelection& solvers) {
+    QPGenerator qpgen;
+    qpgen.addBezier(3, 0);
+
+    return Optimizer(
+            std::make_shared<rlss::AlignedBoxCollisionShape<double, DIM>>(
+                AlignedBox(VectorDIM(-0.1, -0.1), VectorDIM(0.1, 0.1))),
+            qpgen,
+            AlignedBox(VectorDIM(0, 0), VectorDIM(5, 5)),
+            1,
+            {{1, 1.0}},
+            {1.0},
+            {},
+            0.5,
+            rlss::ObstacleConstraintGenerator::SVM,
+            solvers,
+            true
+    );
+}
+
+bool optimize(Optimizer& opt) {
+    OccupancyGrid grid(OccupancyGrid::Coordinate(0.5, 0.5));
+    StdVectorVectorDIM segments {VectorDIM(1, 1), VectorDIM(2, 2)};
+    StdVectorVectorDIM state {VectorDIM(1, 1), VectorDIM(0, 0)};
+
+    return opt.optimize(segments, {1.0}, {}, grid, state).has_value();
+}
+
+} // namespace
+
+TEST_CASE("failed hard solves race the soft solve", "[RLSSHardSoftOptimizer]") {
+    // the hard solve fails once it saw the soft solve start, which it
+    // only sees if they run at the same time
+    auto soft_started = std::make_shared<Gate>();
+    auto hard_saw_soft = std::make_shared<bool>(false);
+    registerFunctionSolver("failing_hard", [soft_started, hard_saw_soft]() {
+        *hard_saw_soft = soft_started->waitStarted(1);
+        return QPWrappers::OptReturnType::Infeasible;
+    });
+    registerFunctionSolver("signalling_soft", [soft_started]() {
+        soft_started->open();
+        return soft_started->solve();
+    });
+
+    rlss::QPSolverSelection solvers;
+    solvers.hard = "failing_hard";
+    solvers.soft = "signalling_soft";
+    Optimizer opt = optimizer(solvers);
+
+    REQUIRE(optimize(opt));
+    REQUIRE(*hard_saw_soft);
+}
+
+TEST_CASE("at most one abandoned soft solve runs", "[RLSSHardSoftOptimizer]") {
+    auto gate = std::make_shared<Gate>();
+    registerFunctionSolver("succeeding_hard", []() {
+        return QPWrappers::OptReturnType::Optimal;
+    });
+    registerFunctionSolver("gated_soft", [gate]() {
+        return gate->solve();
+    });
+
+    rlss::QPSolverSelection solvers;
+    solvers.hard = "succeeding_hard";
+    solvers.soft = "gated_soft";
+    Optimizer opt = optimizer(solvers);
+
+    // the first call leaves its soft solve waiting at the gate. the others
+    // do not wait for it and do not race while it runs.
+    for(int i = 0; i < 3; i++) {
+        REQUIRE(optimize(opt));
+    }
+    REQUIRE(gate->waitStarted(1));
+    REQUIRE(gate->started() == 1);
+    REQUIRE(gate->finished() == 0);
+
+    // once the abandoned solve returned, calls race again
+    gate->open();
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(gate->started() == 1 && std::chrono::steady_clock::now() < give_up) {
+        REQUIRE(optimize(opt));
+    }
+    REQUIRE(gate->started() >= 2);
+}
@@ -0,0 +1,270 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+// allocations of the code of RLSS::plan itself, with stub components whose
+// allocations are not counted. the bundled components are not covered:
+// search paths, QP problems and curves are still allocated on every call.
+
+#include <rlss/RLSS.hpp>
+#include <rlss/TrajectoryOptimizers/RLSSHardOptimizer.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace {
+
+// allocations of all threads are counted while counting is set, so that
+// the allocations of the attempts on the speculative threads count as well
+std::atomic<bool> counting{false};
+std::atomic<std::size_t> allocation_count{0};
+
+// allocations of the planning components themselves are not counted on the
+// threads where an Uncounted is alive
+thread_local bool uncounted = false;
+
+class Uncounted {
+public:
+    Uncounted(): m_uncounted(uncounted) {
+        uncounted = true;
+    }
+
+    ~Uncounted() {
+        uncounted = m_uncounted;
+    }
+
+private:
+    bool m_uncounted;
+};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if(counting && !uncounted) {
+        allocation_count++;
+    }
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+constexpr unsigned int DIM = 2U;
+using VectorDIM = rlss::internal::VectorDIM<double, DIM>;
+using StdVectorVectorDIM = rlss::internal::StdVectorVectorDIM<double, DIM>;
+using AlignedBox = rlss::internal::AlignedBox<double, DIM>;
+using OccupancyGrid = rlss::OccupancyGrid<double, DIM>;
+using PiecewiseCurve = splx::PiecewiseCurve<double, DIM>;
+using Bezier = splx::Bezier<double, DIM>;
+using RLSS = rlss::RLSS<double, DIM>;
+
+class FixedGoalSelector: public rlss::GoalSelector<double, DIM> {
+public:
+    std::optional<std::pair<VectorDIM, double>> select(
+            const VectorDIM& current_position,
+            const OccupancyGrid& occupancy_grid,
+            double current_time) override {
+        return std::make_pair(VectorDIM(3, 1), 1.0);
+    }
+};
+
+class StraightSearcher: public rlss::DiscretePathSearcher<double, DIM> {
+public:
+    std::optional<std::pair<StdVectorVectorDIM, std::vector<double>>> search(
+            const VectorDIM& start,
+            const VectorDIM& goal,
+            double time_horizon,
+            const OccupancyGrid& occupancy_grid) override {
+        Uncounted uncounted;
+        return std::make_pair(
+                StdVectorVectorDIM{start, (start + goal) / 2, goal},
+                std::vector<double>{time_horizon / 2, time_horizon / 2});
+    }
+};
+
+// fails for the durations of the first attempt, so that each plan rescales
+// once, and returns the straight line through the segments otherwise
+class RescalingOptimizer: public rlss::TrajectoryOptimizer<double, DIM> {
+public:
+    std::optional<PiecewiseCurve> optimize(
+            const StdVectorVectorDIM& segments,
+            const std::vector<double>& durations,
+            const std::vector<AlignedBox>& oth_rbt_col_shape_bboxes,
+            const OccupancyGrid& occupancy_grid,
+            const StdVectorVectorDIM& current_robot_state) override {
+        Uncounted uncounted;
+        this->m_solver_durations.clear();
+        this->m_solver_durations.emplace_back("stub", 1);
+
+        if(durations[0] <= 0.5) {
+            return std::nullopt;
+        }
+        PiecewiseCurve curve;
+        for(std::size_t i = 0; i < durations.size(); i++) {
+            Bezier bezier(durations[i]);
+            bezier.appendControlPoint(segments[i]);
+            bezier.appendControlPoint(segments[i + 1]);
+            curve.addPiece(bezier);
+        }
+        return curve;
+    }
+
+    std::shared_ptr<rlss::TrajectoryOptimizer<double, DIM>>
+            clone() const override {
+        return std::make_shared<RescalingOptimizer>();
+    }
+};
+
+class AlwaysValid: public rlss::ValidityChecker<double, DIM> {
+public:
+    bool isValid(const PiecewiseCurve& curve) override {
+        return true;
+    }
+
+    std::shared_ptr<rlss::ValidityChecker<double, DIM>>
+            clone() const override {
+        return std::make_shared<AlwaysValid>();
+    }
+};
+
+// returns the zero solution
+class ZeroSolver: public rlss::internal::QPSolver<double> {
+public:
+    using Base = rlss::internal::QPSolver<double>;
+
+    ZeroSolver(): Base("zero") {
+
+    }
+
+    void setFeasibilityTolerance(double tolerance) override {
+
+    }
+
+protected:
+    OptReturnType initImpl(const Problem& problem, Vector& soln) override {
+        soln.setZero(problem.num_vars());
+        return OptReturnType::Optimal;
+    }
+
+    OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) override {
+        return this->initImpl(problem, soln);
+    }
+};
+
+} // namespace
+
+TEST_CASE("RLSS::plan does not allocate besides its components",
+          "[RLSS]") {
+    // without and with speculative rescaling
+    const unsigned int speculative_rescaling_count = GENERATE(1u, 3u);
+    RLSS planner(
+            std::make_shared<FixedGoalSelector>(),
+            std::make_shared<RescalingOptimizer>(),
+            std::make_shared<StraightSearcher>(),
+            std::make_shared<AlwaysValid>(),
+            10,
+            1.5,
+            speculative_rescaling_count
+    );
+
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    grid.setOccupancy(OccupancyGrid::Index(5, 5));
+    const OccupancyGrid& shared_grid = grid;
+    const std::vector<AlignedBox> other_robots {
+        AlignedBox(VectorDIM(2, 2), VectorDIM(2.2, 2.2)),
+        AlignedBox(VectorDIM(-1, 3), VectorDIM(-0.8, 3.2))
+    };
+    const std::vector<AlignedBox> dynamic_obstacles {
+        AlignedBox(VectorDIM(4, 0), VectorDIM(4.5, 0.5))
+    };
+    StdVectorVectorDIM state{VectorDIM(1, 1)};
+
+    auto plan = [&](double time) {
+        return planner.plan(
+                time, state, other_robots, shared_grid, dynamic_obstacles);
+    };
+
+    // the first calls size the buffers of the planner
+    for(int i = 0; i < 3; i++) {
+        REQUIRE(plan(i));
+    }
+
+    allocation_count = 0;
+    for(int i = 3; i < 13; i++) {
+        counting = true;
+        std::optional<PiecewiseCurve> curve = plan(i);
+        counting = false;
+        REQUIRE(curve);
+    }
+    REQUIRE(allocation_count.load() == 0);
+}
+
+TEST_CASE("hard optimization allocations do not grow across calls",
+          "[RLSS]") {
+    rlss::internal::QPSolverRegistry<double>::instance().registerSolver(
+        "zero",
+        []() {
+            return std::unique_ptr<rlss::internal::QPSolver<double>>(
+                    new ZeroSolver());
+        }
+    );
+    rlss::QPSolverSelection solvers;
+    solvers.hard = solvers.soft = solvers.svm = solvers.lp = "zero";
+
+    splx::PiecewiseCurveQPGenerator<double, DIM> qpgen;
+    qpgen.addBezier(3, 0);
+    qpgen.addBezier(3, 0);
+    rlss::RLSSHardOptimizer<double, DIM> optimizer(
+            std::make_shared<rlss::AlignedBoxCollisionShape<double, DIM>>(
+                AlignedBox(VectorDIM(-0.1, -0.1), VectorDIM(0.1, 0.1))),
+            qpgen,
+            AlignedBox(VectorDIM(-5, -5), VectorDIM(5, 5)),
+            1,
+            {{1, 1.0}},
+            {1.0, 1.0},
+            0.5,
+            rlss::ObstacleConstraintGenerator::SVM,
+            solvers
+    );
+
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    const std::vector<AlignedBox> other_robots {
+        AlignedBox(VectorDIM(2, 2), VectorDIM(2.2, 2.2))
+    };
+    StdVectorVectorDIM segments{VectorDIM(0, 0), VectorDIM(1, 0),
+                                VectorDIM(1, 1)};
+    StdVectorVectorDIM state{VectorDIM(0, 0), VectorDIM(0, 0)};
+
+    std::vector<std::size_t> counts;
+    for(int i = 0; i < 5; i++) {
+        allocation_count = 0;
+        counting = true;
+        auto curve = optimizer.optimize(
+                segments, {1.0, 1.0}, other_robots, grid, state);
+        counting = false;
+        REQUIRE(curve);
+        counts.push_back(allocation_count);
+    }
+
+    // the count is not zero, as the svm problems, the problem of the
+    // generator and the temporaries of problem generation are allocated on
+    // every call
+    for(std::size_t i = 2; i < counts.size(); i++) {
+        REQUIRE(counts[i] == counts[1]);
+    }
+}
@@ -0,0 +1,231 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/RLSS.hpp>
+#include <rlss/TrajectoryOptimizers/RLSSHardOptimizer.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <cmath>
+#include <memory>
+
+namespace {
+
+constexpr unsigned int DIM = 2U;
+using VectorDIM = rlss::internal::VectorDIM<double, DIM>;
+using StdVectorVectorDIM = rlss::internal::StdVectorVectorDIM<double, DIM>;
+using AlignedBox = rlss::internal::AlignedBox<double, DIM>;
+using OccupancyGrid = rlss::OccupancyGrid<double, DIM>;
+using PiecewiseCurve = splx::PiecewiseCurve<double, DIM>;
+using Bezier = splx::Bezier<double, DIM>;
+using Hyperplane = rlss::internal::Hyperplane<double, DIM>;
+using RLSS = rlss::RLSS<double, DIM>;
+
+class FixedGoalSelector: public rlss::GoalSelector<double, DIM> {
+public:
+    std::optional<std::pair<VectorDIM, double>> select(
+            const VectorDIM& current_position,
+            const OccupancyGrid& occupancy_grid,
+            double current_time) override {
+        return std::make_pair(VectorDIM(3, 1), 1.0);
+    }
+};
+
+class StraightSearcher: public rlss::DiscretePathSearcher<double, DIM> {
+public:
+    std::optional<std::pair<StdVectorVectorDIM, std::vector<double>>> search(
+            const VectorDIM& start,
+            const VectorDIM& goal,
+            double time_horizon,
+            const OccupancyGrid& occupancy_grid) override {
+        return std::make_pair(
+                StdVectorVectorDIM{start, (start + goal) / 2, goal},
+                std::vector<double>{time_horizon / 2, time_horizon / 2});
+    }
+};
+
+// fails for durations shorter than fail_below and returns the straight
+// line through the segments otherwise
+class ThresholdOptimizer: public rlss::TrajectoryOptimizer<double, DIM> {
+public:
+    explicit ThresholdOptimizer(double fail_below)
+        : m_fail_below(fail_below)
+    {
+
+    }
+
+    std::optional<PiecewiseCurve> optimize(
+            const StdVectorVectorDIM& segments,
+            const std::vector<double>& durations,
+            const std::vector<AlignedBox>& oth_rbt_col_shape_bboxes,
+            const OccupancyGrid& occupancy_grid,
+            const StdVectorVectorDIM& current_robot_state) override {
+        this->m_solver_durations.clear();
+        this->m_solver_durations.emplace_back("threshold", 1);
+
+        PiecewiseCurve curve;
+        for(std::size_t i = 0; i < durations.size(); i++) {
+            if(durations[i] < m_fail_below) {
+                return std::nullopt;
+            }
+            Bezier bezier(durations[i]);
+            bezier.appendControlPoint(segments[i]);
+            bezier.appendControlPoint(segments[i + 1]);
+            curve.addPiece(bezier);
+        }
+        return curve;
+    }
+
+    std::shared_ptr<rlss::TrajectoryOptimizer<double, DIM>>
+            clone() const override {
+        return std::make_shared<ThresholdOptimizer>(m_fail_below);
+    }
+
+private:
+    double m_fail_below;
+};
+
+// accepts curves of at least valid_from duration
+class ThresholdValidityChecker: public rlss::ValidityChecker<double, DIM> {
+public:
+    explicit ThresholdValidityChecker(double valid_from)
+        : m_valid_from(valid_from)
+    {
+
+    }
+
+    bool isValid(const PiecewiseCurve& curve) override {
+        return curve.maxParameter() >= m_valid_from;
+    }
+
+    std::shared_ptr<rlss::ValidityChecker<double, DIM>>
+            clone() const override {
+        return std::make_shared<ThresholdValidityChecker>(m_valid_from);
+    }
+
+private:
+    double m_valid_from;
+};
+
+RLSS thresholdPlanner(
+        double fail_below,
+        double valid_from,
+        unsigned int speculative_rescaling_count) {
+    return RLSS(
+            std::make_shared<FixedGoalSelector>(),
+            std::make_shared<ThresholdOptimizer>(fail_below),
+            std::make_shared<StraightSearcher>(),
+            std::make_shared<ThresholdValidityChecker>(valid_from),
+            10,
+            1.5,
+            speculative_rescaling_count
+    );
+}
+
+} // namespace
+
+TEST_CASE("speculative rescaling plans like sequential rescaling", "[RLSS]") {
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    StdVectorVectorDIM state{VectorDIM(1, 1)};
+
+    // (fail below, valid from) for pieces of initial duration 0.5 rescaled
+    // by 1.5 in each attempt. optimization fails in the first two attempts
+    // and the curve is valid from the fifth one on, is never valid, and is
+    // valid in the first attempt.
+    const std::vector<std::pair<double, double>> thresholds {
+        {0.5 * 1.5 * 1.5 - 1e-6, std::pow(1.5, 4) - 1e-6},
+        {0, 1e6},
+        {0, 0}
+    };
+
+    for(const auto& [fail_below, valid_from]: thresholds) {
+        RLSS sequential = thresholdPlanner(fail_below, valid_from, 1);
+        sequential.setKeepStatisticsRecords(true);
+        std::optional<PiecewiseCurve> expected
+                = sequential.plan(0, state, {}, grid);
+
+        for(unsigned int count: {2u, 3u, 7u}) {
+            RLSS speculative = thresholdPlanner(fail_below, valid_from, count);
+            speculative.setKeepStatisticsRecords(true);
+            std::optional<PiecewiseCurve> curve
+                    = speculative.plan(0, state, {}, grid);
+
+            REQUIRE(bool(curve) == bool(expected));
+            if(expected) {
+                REQUIRE(curve->numPieces() == expected->numPieces());
+                for(std::size_t p = 0; p < curve->numPieces(); p++) {
+                    const Bezier& piece = (*curve)[p];
+                    const Bezier& expected_piece = (*expected)[p];
+                    REQUIRE(piece.maxParameter()
+                            == expected_piece.maxParameter());
+                    REQUIRE(piece.numControlPoints()
+                            == expected_piece.numControlPoints());
+                    for(std::size_t i = 0; i < piece.numControlPoints(); i++) {
+                        REQUIRE(piece[i] == expected_piece[i]);
+                    }
+                }
+            }
+
+#ifdef ENABLE_RLSS_STATISTICS
+            const auto& sf = speculative.statisticsStorage().sfStatistics();
+            const auto& expected_sf
+                    = sequential.statisticsStorage().sfStatistics();
+            REQUIRE(sf.size() == 1);
+            REQUIRE(expected_sf.size() == 1);
+            REQUIRE(sf[0].trajectoryOptimizationSuccessFail()
+                    == expected_sf[0].trajectoryOptimizationSuccessFail());
+            REQUIRE(sf[0].planningSuccessFail()
+                    == expected_sf[0].planningSuccessFail());
+
+            const auto& durations
+                    = speculative.statisticsStorage().durationStatistics();
+            const auto& expected_durations
+                    = sequential.statisticsStorage().durationStatistics();
+            REQUIRE(durations.size() == 1);
+            REQUIRE(expected_durations.size() == 1);
+            REQUIRE(durations[0].trajectoryOptimizationDurations().size()
+                    == expected_durations[0]
+                        .trajectoryOptimizationDurations().size());
+            REQUIRE(durations[0].validityCheckDurations().size()
+                    == expected_durations[0].validityCheckDurations().size());
+            REQUIRE(durations[0].solverDurations().at("threshold").size()
+                    == expected_durations[0]
+                        .solverDurations().at("threshold").size());
+#endif
+        }
+    }
+}
+
+TEST_CASE("clones keep the optimizer state", "[RLSS]") {
+    using Optimizer = rlss::RLSSHardOptimizer<double, DIM>;
+
+    splx::PiecewiseCurveQPGenerator<double, DIM> qpgen;
+    qpgen.addBezier(3, 0);
+    Optimizer optimizer(
+            std::make_shared<rlss::AlignedBoxCollisionShape<double, DIM>>(
+                AlignedBox(VectorDIM(-0.1, -0.1), VectorDIM(0.1, 0.1))),
+            qpgen,
+            AlignedBox(VectorDIM(0, 0), VectorDIM(5, 5)),
+            1,
+            {{1, 1.0}},
+            {1.0},
+            0.5
+    );
+
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    StdVectorVectorDIM segments{VectorDIM(1, 1), VectorDIM(2, 2)};
+    StdVectorVectorDIM state{VectorDIM(1, 1), VectorDIM(0, 0)};
+    auto optimize = [&](rlss::TrajectoryOptimizer<double, DIM>& opt) {
+        return opt.optimize(segments, {1.0}, {}, grid, state);
+    };
+
+    REQUIRE(optimize(*optimizer.clone()));
+
+    // a robot safety hyperplane without an other robot is rejected
+    optimizer.setRobotSafetyHyperplanes({Hyperplane(VectorDIM(1, 0), 0)});
+    REQUIRE(!optimize(*optimizer.clone()));
+    optimizer.clearRobotSafetyHyperplanes();
+
+    // an expired deadline stops the optimization
+    optimizer.setDeadline(rlss::internal::Deadline::after(
+            std::chrono::milliseconds(0)));
+    REQUIRE(!optimize(*optimizer.clone()));
+}
@@ -0,0 +1,110 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/ReplanningScheduler.hpp>
+#include <cmath>
+
+TEST_CASE("replanning scheduler", "[ReplanningScheduler]") {
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+    using AlignedBox = rlss::internal::AlignedBox<double, 2U>;
+    using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
+    using ReplanningScheduler = rlss::ReplanningScheduler<double, 2U>;
+
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    grid.setOccupancy(VectorDIM(20.25, 0.25));
+
+    // robot 0 is next to robot 1, robot 2 is next to an obstacle, robot 3
+    // is alone
+    std::vector<AlignedBox> boxes {
+        AlignedBox(VectorDIM(0, 0), VectorDIM(0.5, 0.5)),
+        AlignedBox(VectorDIM(0.6, 0), VectorDIM(1.1, 0.5)),
+        AlignedBox(VectorDIM(19.5, 0), VectorDIM(19.75, 0.5)),
+        AlignedBox(VectorDIM(10, 10), VectorDIM(10.5, 10.5))
+    };
+    std::vector<double> tracking_errors {0, 0, 0, 0};
+
+    ReplanningScheduler scheduler(4, 0.25, 1, 1, 0.1, 10);
+
+    // robots that have not planned yet plan regardless of the budget
+    std::vector<double> urgencies
+            = scheduler.urgencies(0, boxes, tracking_errors, grid);
+    for(double urgency: urgencies) {
+        REQUIRE(std::isinf(urgency));
+    }
+    REQUIRE(scheduler.schedule(0, boxes, tracking_errors, grid)
+            == std::vector<bool>{true, true, true, true});
+    for(std::size_t i = 0; i < 4; i++) {
+        scheduler.planned(i, 0, 0.1, true);
+    }
+
+    urgencies = scheduler.urgencies(1, boxes, tracking_errors, grid);
+    REQUIRE(urgencies[0] == Approx(0.9 + 0.1));
+    REQUIRE(urgencies[1] == Approx(0.9 + 0.1));
+    REQUIRE(urgencies[2] == Approx(0.75 + 0.1));
+    REQUIRE(urgencies[3] == Approx(0.1));
+
+    // two robots fit in the budget
+    REQUIRE(scheduler.schedule(1, boxes, tracking_errors, grid)
+            == std::vector<bool>{true, true, false, false});
+
+    // tracking error makes robot 3 the most urgent
+    tracking_errors[3] = 1;
+    REQUIRE(scheduler.schedule(1, boxes, tracking_errors, grid)
+            == std::vector<bool>{true, false, false, true});
+
+    // only candidates plan, the most urgent one even over the budget
+    scheduler.planned(2, 1, 1, true);
+    REQUIRE(scheduler.schedule(
+                2, boxes, tracking_errors, grid,
+                std::vector<bool>{false, false, true, false})
+            == std::vector<bool>{false, false, true, false});
+}
+
+TEST_CASE("safety critical replans ignore the budget", "[ReplanningScheduler]") {
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+    using AlignedBox = rlss::internal::AlignedBox<double, 2U>;
+    using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
+    using ReplanningScheduler = rlss::ReplanningScheduler<double, 2U>;
+
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    std::vector<AlignedBox> boxes;
+    for(int i = 0; i < 4; i++) {
+        boxes.emplace_back(VectorDIM(10 * i, 0), VectorDIM(10 * i + 0.5, 0.5));
+    }
+
+    // robot 3 is the least urgent and only robot 0 alone exceeds the budget
+    std::vector<double> tracking_errors {0.3, 0.2, 0.1, 0};
+    ReplanningScheduler scheduler(4, 0.35, 1, 0, 0, 1);
+    scheduler.planned(0, 0, 1, true);
+    scheduler.planned(1, 0, 0.1, true);
+    scheduler.planned(2, 0, 0.1, true);
+    scheduler.planned(3, 0, 0.1, true);
+
+    // robot 0 is the most urgent and plans over the budget when nothing
+    // else plans. robots that do not fit after it are skipped.
+    REQUIRE(scheduler.schedule(1, boxes, tracking_errors, grid)
+            == std::vector<bool>{true, false, false, false});
+
+    // safety critical robot 3 plans first. robot 0 does not fit in the
+    // rest of the budget, the next two still do.
+    REQUIRE(scheduler.schedule(
+                1, boxes, tracking_errors, grid,
+                std::vector<bool>(),
+                std::vector<bool>{false, false, false, true})
+            == std::vector<bool>{false, true, true, true});
+
+    // safety critical robot 0 plans although it alone exceeds the budget,
+    // and robots that would only replan for urgency are trimmed
+    REQUIRE(scheduler.schedule(
+                1, boxes, tracking_errors, grid,
+                std::vector<bool>(),
+                std::vector<bool>{true, false, false, false})
+            == std::vector<bool>{true, false, false, false});
+
+    // every safety critical robot plans however far over the budget
+    REQUIRE(scheduler.schedule(
+                1, boxes, tracking_errors, grid,
+                std::vector<bool>{true, true, true, false},
+                std::vector<bool>{true, true, true, false})
+            == std::vector<bool>{true, true, true, false});
+}
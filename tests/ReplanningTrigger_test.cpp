@@ -0,0 +1,108 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/ReplanningTrigger.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <memory>
+
+TEST_CASE("replanning trigger", "[ReplanningTrigger]") {
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+    using AlignedBox = rlss::internal::AlignedBox<double, 2U>;
+    using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
+    using PiecewiseCurve = splx::PiecewiseCurve<double, 2U>;
+    using Bezier = splx::Bezier<double, 2U>;
+    using AlignedBoxCollisionShape = rlss::AlignedBoxCollisionShape<double, 2U>;
+    using ReplanningTrigger = rlss::ReplanningTrigger<double, 2U>;
+    using ReplanningReason = rlss::ReplanningReason;
+
+    // 1 unit per second along x
+    Bezier bezier(10);
+    bezier.appendControlPoint(VectorDIM(0, 0));
+    bezier.appendControlPoint(VectorDIM(10, 0));
+    PiecewiseCurve trajectory;
+    trajectory.addPiece(bezier);
+
+    auto collision_shape = std::make_shared<AlignedBoxCollisionShape>(
+            AlignedBox(VectorDIM(-0.25, -0.25), VectorDIM(0.25, 0.25)));
+
+    ReplanningTrigger trigger(collision_shape, trajectory, 0.1, 2, 0.05);
+    OccupancyGrid grid(VectorDIM(0.5, 0.5));
+    std::vector<AlignedBox> other_robot_boxes;
+
+    // no trajectory is planned yet
+    REQUIRE(trigger.needsReplanning(
+            0, VectorDIM(0, 0), trajectory, 0, 0.1, grid, other_robot_boxes));
+    REQUIRE(trigger.replanningReason(
+            0, VectorDIM(0, 0), trajectory, 0, 0.1, grid, other_robot_boxes)
+            == ReplanningReason::NoTrajectory);
+
+    trigger.setLastPlanningTime(0);
+    REQUIRE(!trigger.needsReplanning(
+            1, VectorDIM(1, 0), trajectory, 1, 0.1, grid, other_robot_boxes));
+    REQUIRE(trigger.replanningReason(
+            1, VectorDIM(1, 0), trajectory, 1, 0.1, grid, other_robot_boxes)
+            == ReplanningReason::None);
+
+    SECTION("maximum age") {
+        REQUIRE(trigger.replanningReason(
+                2, VectorDIM(2, 0), trajectory, 2, 0.1, grid,
+                other_robot_boxes)
+                == ReplanningReason::MaximumAge);
+
+        // safety critical reasons are reported over the age
+        REQUIRE(trigger.replanningReason(
+                2, VectorDIM(2, 0.2), trajectory, 2, 0.1, grid,
+                other_robot_boxes)
+                == ReplanningReason::TrajectoryDeviation);
+    }
+
+    SECTION("deviation from the trajectory") {
+        REQUIRE(trigger.replanningReason(
+                1, VectorDIM(1, 0.2), trajectory, 1, 0.1, grid,
+                other_robot_boxes)
+                == ReplanningReason::TrajectoryDeviation);
+    }
+
+    SECTION("obstacle on the rest of the trajectory") {
+        grid.setOccupancy(VectorDIM(8, 0));
+        REQUIRE(trigger.replanningReason(
+                1, VectorDIM(1, 0), trajectory, 1, 0.1, grid,
+                other_robot_boxes)
+                == ReplanningReason::ObstacleCollision);
+    }
+
+    SECTION("robot close to another robot") {
+        other_robot_boxes.emplace_back(VectorDIM(1.3, 1), VectorDIM(1.8, 2));
+        REQUIRE(!trigger.needsReplanning(
+                1, VectorDIM(1, 0), trajectory, 1, 0.1, grid,
+                other_robot_boxes));
+
+        other_robot_boxes.emplace_back(VectorDIM(1.3, 0), VectorDIM(1.8, 1));
+        REQUIRE(trigger.replanningReason(
+                1, VectorDIM(1, 0), trajectory, 1, 0.1, grid,
+                other_robot_boxes)
+                == ReplanningReason::RobotHyperplaneCrossing);
+    }
+
+    SECTION("deviation from the original trajectory") {
+        // the robot follows the same path one second late
+        REQUIRE(trigger.replanningReason(
+                1, VectorDIM(0, 0), trajectory, 0, 0.1, grid,
+                other_robot_boxes)
+                == ReplanningReason::OriginalTrajectoryDeviation);
+    }
+}
+
+TEST_CASE("safety critical replanning reasons", "[ReplanningTrigger]") {
+    using ReplanningReason = rlss::ReplanningReason;
+
+    REQUIRE(!rlss::isSafetyCritical(ReplanningReason::None));
+    REQUIRE(rlss::isSafetyCritical(ReplanningReason::NoTrajectory));
+    REQUIRE(!rlss::isSafetyCritical(ReplanningReason::MaximumAge));
+    REQUIRE(rlss::isSafetyCritical(ReplanningReason::TrajectoryDeviation));
+    REQUIRE(rlss::isSafetyCritical(ReplanningReason::ObstacleCollision));
+    REQUIRE(rlss::isSafetyCritical(
+            ReplanningReason::RobotHyperplaneCrossing));
+    REQUIRE(!rlss::isSafetyCritical(
+            ReplanningReason::OriginalTrajectoryDeviation));
+}
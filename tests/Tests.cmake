@@ -21,4 +21,22 @@ generate_test(internal_SVM_test)
 generate_test(OccupancyGrid_test)
 generate_test(internal_DiscreteSearch_test)
 generate_test(internal_BFS_test)
-generate_test(internal_Statistics_test)
\ No newline at end of file
+generate_test(internal_Statistics_test)
+generate_test(internal_BatchEval_test)
+generate_test(internal_FreeSpaceComponents_test)
+generate_test(internal_RLSSOptimization_test)
+generate_test(internal_QPSolver_test)
+generate_test(internal_CostHessian_test)
+generate_test(internal_PlannerWorkspace_test)
+generate_test(internal_MonotonicArena_test)
+generate_test(internal_ThreadPool_test)
+generate_test(internal_SpatialHash_test)
+generate_test(internal_Deadline_test)
+generate_test(RLSS_test)
+generate_test(RLSSHardSoftOptimizer_test)
+generate_test(RLSS_allocation_test)
+generate_test(AsyncRLSS_test)
+generate_test(ReplanningTrigger_test)
+generate_test(ReplanningScheduler_test)
+generate_test(internal_JSONLinesWriter_test)
+generate_test(internal_JSONBuilder_test)
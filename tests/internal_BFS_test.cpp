@@ -8,6 +8,7 @@
 #include <rlss/OccupancyGrid.hpp>
 #include <rlss/internal/Util.hpp>
 #include <unordered_set>
+#include <random>
 
 TEST_CASE("BFS in 2D", "[bfs]") {
     using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
@@ -98,4 +99,62 @@ TEST_CASE("BFS in 2D", "[bfs]") {
 
 
     REQUIRE(bfs_result == bfs_expected_result);
-}
\ No newline at end of file
+}
+TEST_CASE("BFS bitmap in 3D", "[bfs]") {
+    using OccupancyGrid = rlss::OccupancyGrid<double, 3U>;
+    using AlColShape = rlss::AlignedBoxCollisionShape<double, 3U>;
+    using ColShape = rlss::CollisionShape<double, 3U>;
+    using AlignedBox = typename OccupancyGrid::AlignedBox;
+    using VectorDIM = typename OccupancyGrid::VectorDIM;
+    using Coordinate = OccupancyGrid::Coordinate;
+    using Index = OccupancyGrid::Index;
+    using UnorderedIndexSet = OccupancyGrid::UnorderedIndexSet;
+
+    auto collision_shape = std::static_pointer_cast<ColShape>(
+        std::make_shared<AlColShape>(
+            AlignedBox(
+                VectorDIM{-0.33, -0.33, -0.33},
+                VectorDIM{0.33, 0.33, 0.33}
+            )
+        )
+    );
+
+    OccupancyGrid grid(Coordinate(0.5, 0.5, 0.5));
+    AlignedBox workspace(VectorDIM(0, 0, 0), VectorDIM(20, 20, 10));
+
+    VectorDIM start(1.2, 5, 1.7);
+    AlignedBox start_region(start.array() - 1, start.array() + 1);
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(0, 20);
+    for(int i = 0; i < 60; i++) {
+        VectorDIM min(dist(gen), dist(gen), dist(gen) / 2);
+        AlignedBox obstacle(min, min + VectorDIM(0.8, 3, 2));
+        if(!obstacle.intersects(start_region)) {
+            grid.addObstacle(obstacle);
+        }
+    }
+    grid.addTemporaryObstacle(
+        AlignedBox(VectorDIM(10, 0, 0), VectorDIM(10.5, 20, 10))
+    );
+
+    rlss::internal::ThreadPool thread_pool(4);
+    auto sequential = rlss::internal::BFSBitmap<double, 3U>(
+        start, grid, workspace, collision_shape
+    );
+    auto parallel = rlss::internal::BFSBitmap<double, 3U>(
+        start, grid, workspace, collision_shape, &thread_pool
+    );
+
+    UnorderedIndexSet sequential_set = sequential.toIndexSet();
+    REQUIRE(sequential_set.size() == sequential.count());
+    REQUIRE(sequential_set.size() > 1000);
+    REQUIRE(parallel.toIndexSet() == sequential_set);
+
+    for(const Index& idx: sequential_set) {
+        REQUIRE(sequential.contains(idx));
+        REQUIRE(idx(0) < 20);
+    }
+    REQUIRE(!sequential.contains(Index(30, 5, 3)));
+    REQUIRE(!sequential.contains(grid.getIndex(VectorDIM(15, 5, 1.7))));
+}
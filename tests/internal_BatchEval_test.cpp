@@ -0,0 +1,99 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <rlss/internal/BatchEval.hpp>
+#include <splx/curve/PiecewiseCurve.hpp>
+#include <splx/curve/Bezier.hpp>
+
+TEST_CASE("Batch evaluation matches pointwise evaluation", "[internal::batchEval]") {
+    using PiecewiseCurve = splx::PiecewiseCurve<double, 3U>;
+    using Bezier = splx::Bezier<double, 3U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 3U>;
+
+    PiecewiseCurve curve;
+
+    Bezier first(1.5);
+    first.appendControlPoint(VectorDIM(0, 0, 0));
+    first.appendControlPoint(VectorDIM(1, 2, 0.5));
+    first.appendControlPoint(VectorDIM(2, -1, 1));
+    first.appendControlPoint(VectorDIM(3, 0, 2));
+    curve.addPiece(first);
+
+    Bezier second(0.7);
+    second.appendControlPoint(VectorDIM(3, 0, 2));
+    second.appendControlPoint(VectorDIM(4, 1, 2.5));
+    second.appendControlPoint(VectorDIM(4.5, 3, 1));
+    curve.addPiece(second);
+
+    std::vector<double> params;
+    for(double param = 0; param < curve.maxParameter(); param += 0.05) {
+        params.push_back(param);
+    }
+    params.push_back(curve.maxParameter());
+
+    for(unsigned int k = 0; k <= 4; k++) {
+        auto values = rlss::internal::batchEval<double, 3U>(curve, params, k);
+        REQUIRE(values.cols() == params.size());
+        for(std::size_t j = 0; j < params.size(); j++) {
+            VectorDIM expected = curve.eval(params[j], k);
+            REQUIRE((values.col(j) - expected).norm() < 1e-9);
+        }
+    }
+}
+
+TEST_CASE("Batch evaluation rejects invalid parameters", "[internal::batchEval]") {
+    using PiecewiseCurve = splx::PiecewiseCurve<double, 2U>;
+    using Bezier = splx::Bezier<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+
+    PiecewiseCurve curve;
+    Bezier piece(1);
+    piece.appendControlPoint(VectorDIM(0, 0));
+    piece.appendControlPoint(VectorDIM(1, 1));
+    curve.addPiece(piece);
+
+    std::vector<double> empty;
+    std::vector<double> unsorted {0.5, 0.2};
+    std::vector<double> out_of_range {0.5, 1.2};
+
+    REQUIRE(rlss::internal::batchEval<double, 2U>(curve, empty, 0).cols() == 0);
+    REQUIRE_THROWS_AS(
+        (rlss::internal::batchEval<double, 2U>(curve, unsorted, 0)),
+        std::domain_error
+    );
+    REQUIRE_THROWS_AS(
+        (rlss::internal::batchEval<double, 2U>(curve, out_of_range, 0)),
+        std::domain_error
+    );
+}
+
+TEST_CASE("Batch evaluation of a zero duration last piece", "[internal::batchEval]") {
+    using PiecewiseCurve = splx::PiecewiseCurve<double, 2U>;
+    using Bezier = splx::Bezier<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+
+    // parameters at the end of a piece are evaluated on it, so only a curve
+    // of zero duration pieces evaluates on its zero duration last piece
+    PiecewiseCurve curve;
+    Bezier first(0);
+    first.appendControlPoint(VectorDIM(1, 1));
+    first.appendControlPoint(VectorDIM(1, 1));
+    curve.addPiece(first);
+
+    Bezier last(0);
+    last.appendControlPoint(VectorDIM(1, 1));
+    last.appendControlPoint(VectorDIM(3, 1));
+    last.appendControlPoint(VectorDIM(4, 0));
+    curve.addPiece(last);
+
+    std::vector<double> params {0, 0};
+
+    auto positions = rlss::internal::batchEval<double, 2U>(curve, params, 0);
+    REQUIRE((positions.col(0) - VectorDIM(1, 1)).norm() < 1e-9);
+    REQUIRE((positions.col(1) - VectorDIM(1, 1)).norm() < 1e-9);
+
+    for(unsigned int k = 1; k <= 3; k++) {
+        auto values = rlss::internal::batchEval<double, 2U>(curve, params, k);
+        REQUIRE(values.cols() == 2);
+        REQUIRE(values.isZero());
+    }
+}
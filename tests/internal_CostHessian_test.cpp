@@ -0,0 +1,122 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <rlss/internal/CostHessian.hpp>
+#include <rlss/internal/BatchEval.hpp>
+#include <splx/curve/PiecewiseCurve.hpp>
+#include <splx/curve/Bezier.hpp>
+#include <splx/opt/PiecewiseCurveQPGenerator.hpp>
+#include <thread>
+
+TEST_CASE("cached hessians match integrated squared derivatives", "[internal::CostHessianCache]") {
+    using PiecewiseCurve = splx::PiecewiseCurve<double, 2U>;
+    using Bezier = splx::Bezier<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+    using Cache = rlss::internal::CostHessianCache<double>;
+
+    Cache& cache = Cache::instance();
+
+    for(double duration: {0.4, 1.0, 2.5}) {
+        Bezier bezier(duration);
+        bezier.appendControlPoint(VectorDIM(0, 0));
+        bezier.appendControlPoint(VectorDIM(1, 2));
+        bezier.appendControlPoint(VectorDIM(2, -1));
+        bezier.appendControlPoint(VectorDIM(3, 0.5));
+        bezier.appendControlPoint(VectorDIM(2, 3));
+        bezier.appendControlPoint(VectorDIM(4, 1));
+        PiecewiseCurve curve;
+        curve.addPiece(bezier);
+
+        // composite simpson rule on the squared derivative, which is a
+        // polynomial of degree at most 10
+        const std::size_t intervals = 200;
+        std::vector<double> params;
+        for(std::size_t i = 0; i <= intervals; i++) {
+            params.push_back(duration * i / intervals);
+        }
+
+        for(unsigned int k = 0; k <= 6; k++) {
+            auto values = rlss::internal::batchEval<double, 2U>(
+                    curve, params, k);
+            double expected = 0;
+            for(std::size_t i = 0; i <= intervals; i++) {
+                double weight = (i == 0 || i == intervals) ? 1
+                                : (i % 2 == 1 ? 4 : 2);
+                expected += weight * values.col(i).squaredNorm();
+            }
+            expected *= duration / intervals / 3;
+
+            rlss::internal::Matrix<double> H = cache.hessian(5, k, duration);
+            REQUIRE(H.rows() == 6);
+            REQUIRE(H.cols() == 6);
+
+            double actual = 0;
+            for(unsigned int d = 0; d < 2; d++) {
+                rlss::internal::Vector<double> cpts(6);
+                for(unsigned int j = 0; j < 6; j++) {
+                    cpts(j) = bezier[j](d);
+                }
+                actual += cpts.dot(H * cpts);
+            }
+
+            REQUIRE(actual == Approx(expected).epsilon(1e-6).margin(1e-9));
+        }
+    }
+
+    REQUIRE(&cache.unitHessian(5, 2) == &cache.unitHessian(5, 2));
+    std::size_t size = cache.size();
+    cache.hessian(5, 2, 0.3);
+    cache.hessian(5, 2, 7.1);
+    REQUIRE(cache.size() == size);
+}
+
+TEST_CASE("cached hessians of zero durations are zero", "[internal::CostHessianCache]") {
+    using Cache = rlss::internal::CostHessianCache<double>;
+
+    for(unsigned int k = 0; k <= 4; k++) {
+        rlss::internal::Matrix<double> H = Cache::instance().hessian(5, k, 0);
+        REQUIRE(H.rows() == 6);
+        REQUIRE(H.allFinite());
+        REQUIRE(H.isZero());
+    }
+}
+
+TEST_CASE("hessian caches are per thread", "[internal::CostHessianCache]") {
+    using Cache = rlss::internal::CostHessianCache<double>;
+
+    const Cache* main_cache = &Cache::instance();
+    const Cache* other_cache = nullptr;
+    std::size_t other_size = 1;
+    std::thread other([&]() {
+        other_cache = &Cache::instance();
+        other_size = Cache::instance().size();
+    });
+    other.join();
+
+    REQUIRE(other_cache != nullptr);
+    REQUIRE(other_cache != main_cache);
+    REQUIRE(other_size == 0);
+}
+
+TEST_CASE("integrated squared derivative cost matches splx", "[internal::CostHessian]") {
+    using QPGen = splx::PiecewiseCurveQPGenerator<double, 2U>;
+
+    for(unsigned int k = 0; k <= 4; k++) {
+        QPGen cached;
+        QPGen expected;
+        for(QPGen* qpgen: {&cached, &expected}) {
+            qpgen->addBezier(7, 0);
+            qpgen->addBezier(7, 0);
+            qpgen->addBezier(5, 0);
+            qpgen->setPieceMaxParameters({0.5, 1.75, 3.0});
+            qpgen->resetProblem();
+        }
+
+        rlss::internal::addIntegratedSquaredDerivativeCosts<double, 2U>(
+                cached, {{k, 0.3}, {2, 1.5}});
+        expected.addIntegratedSquaredDerivativeCost(k, 0.3);
+        expected.addIntegratedSquaredDerivativeCost(2, 1.5);
+
+        REQUIRE(cached.getProblem().Q().isApprox(
+                expected.getProblem().Q(), 1e-9));
+    }
+}
@@ -0,0 +1,71 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/Deadline.hpp>
+#include <rlss/internal/DiscreteSearch.hpp>
+#include <rlss/OccupancyGrid.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
+
+TEST_CASE("deadline expiry", "[internal::Deadline]") {
+    using Deadline = rlss::internal::Deadline;
+
+    Deadline never;
+    REQUIRE(!never.isSet());
+    REQUIRE(!never.expired());
+    REQUIRE(std::isinf(never.remainingSeconds<double>()));
+    REQUIRE_NOTHROW(never.throwIfExpired());
+
+    Deadline later = Deadline::after(std::chrono::hours(1));
+    REQUIRE(later.isSet());
+    REQUIRE(!later.expired());
+    REQUIRE(later.remainingSeconds<double>() > 3500);
+    REQUIRE(later.remainingSeconds<double>() <= 3600);
+
+    Deadline passed = Deadline::after(std::chrono::milliseconds(-1));
+    REQUIRE(passed.expired());
+    REQUIRE(passed.remainingSeconds<double>() == 0);
+    REQUIRE_THROWS_AS(
+            passed.throwIfExpired(), rlss::internal::DeadlineExpired);
+}
+
+TEST_CASE("discrete search stops at the deadline", "[internal::Deadline]") {
+    using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
+    using Coordinate = OccupancyGrid::Coordinate;
+    using AlignedBox = OccupancyGrid::AlignedBox;
+    using AlignedBoxCollisionShape = rlss::AlignedBoxCollisionShape<double, 2U>;
+    using CollisionShape = rlss::CollisionShape<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+    using Deadline = rlss::internal::Deadline;
+
+    OccupancyGrid grid(Coordinate(0.5, 0.5));
+    std::shared_ptr<CollisionShape> collision_shape
+        = std::make_shared<AlignedBoxCollisionShape>(
+            AlignedBox(VectorDIM(-0.35, -0.35), VectorDIM(0.35, 0.35)));
+    AlignedBox workspace(VectorDIM(0, 0), VectorDIM(4.5, 4.5));
+    Coordinate start_position(0.75, 0.75);
+    Coordinate goal_position(3.75, 3.75);
+
+    auto result = rlss::internal::discreteSearch<double, 2U>(
+            start_position,
+            goal_position,
+            grid,
+            workspace,
+            collision_shape,
+            Deadline::after(std::chrono::hours(1))
+    );
+    REQUIRE(result != std::nullopt);
+
+    result = rlss::internal::discreteSearch<double, 2U>(
+            start_position,
+            goal_position,
+            grid,
+            workspace,
+            collision_shape,
+            Deadline::after(std::chrono::milliseconds(-1))
+    );
+    REQUIRE(result == std::nullopt);
+}
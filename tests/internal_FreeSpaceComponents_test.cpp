@@ -0,0 +1,170 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/FreeSpaceComponents.hpp>
+#include <rlss/internal/DenseOccupancyGrid.hpp>
+#include <rlss/internal/BFS.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <rlss/OccupancyGrid.hpp>
+#include <memory>
+#include <optional>
+#include <random>
+
+TEST_CASE("dense occupancy grid counts occupied cells", "[dense_grid]") {
+    using OccupancyGrid = rlss::OccupancyGrid<double, 3U>;
+    using DenseOccupancyGrid = rlss::internal::DenseOccupancyGrid<double, 3U>;
+    using AlignedBox = typename OccupancyGrid::AlignedBox;
+    using VectorDIM = typename OccupancyGrid::VectorDIM;
+    using Coordinate = OccupancyGrid::Coordinate;
+    using Index = OccupancyGrid::Index;
+
+    OccupancyGrid grid(Coordinate(0.5, 0.5, 0.5));
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<long long int> dist(0, 9);
+    for(int i = 0; i < 150; i++) {
+        grid.setOccupancy(Index(dist(gen), dist(gen), dist(gen)));
+    }
+
+    AlignedBox region(VectorDIM(0.1, 0.1, 0.1), VectorDIM(4.9, 4.9, 4.9));
+    DenseOccupancyGrid dense(grid, region);
+
+    REQUIRE(dense.size() == 1000);
+    REQUIRE(dense.gridCellsId() == grid.cellsId());
+
+    for(int i = 0; i < 200; i++) {
+        Index a(dist(gen), dist(gen), dist(gen));
+        Index b(dist(gen), dist(gen), dist(gen));
+        Index min = a.cwiseMin(b);
+        Index max = a.cwiseMax(b);
+
+        std::uint32_t expected = 0;
+        for(const Index& idx: grid.getIndexSet()) {
+            if((idx.array() >= min.array()).all()
+               && (idx.array() <= max.array()).all()) {
+                expected++;
+            }
+        }
+
+        REQUIRE(dense.occupiedCount(min, max) == expected);
+        REQUIRE(dense.isOccupied(min, max) == (expected != 0));
+        REQUIRE(dense.index(dense.linearIndex(min)) == min);
+    }
+
+    REQUIRE(dense.isOccupied(Index(-1, 0, 0), Index(0, 0, 0)));
+    REQUIRE(!dense.contains(Index(10, 0, 0)));
+}
+
+TEST_CASE("free space components agree with BFS", "[free_space_components]") {
+    using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
+    using AlColShape = rlss::AlignedBoxCollisionShape<double, 2U>;
+    using ColShape = rlss::CollisionShape<double, 2U>;
+    using AlignedBox = typename OccupancyGrid::AlignedBox;
+    using VectorDIM = typename OccupancyGrid::VectorDIM;
+    using Coordinate = OccupancyGrid::Coordinate;
+    using Index = OccupancyGrid::Index;
+    using UnorderedIndexSet = OccupancyGrid::UnorderedIndexSet;
+    using FreeSpaceComponents
+            = rlss::internal::FreeSpaceComponents<double, 2U>;
+    using Label = FreeSpaceComponents::Label;
+
+    auto collision_shape = std::static_pointer_cast<ColShape>(
+        std::make_shared<AlColShape>(
+            AlignedBox(
+                VectorDIM{-0.33, -0.33},
+                VectorDIM{0.33, 0.33}
+            )
+        )
+    );
+
+    OccupancyGrid grid(Coordinate(0.5, 0.5));
+    AlignedBox workspace(VectorDIM(0,0), VectorDIM(7, 7));
+
+    FreeSpaceComponents components(workspace, collision_shape);
+    REQUIRE(!components.label(Index(1, 1)));
+
+    // cells reachable from start according to the labels, found the same
+    // way RLSSGoalSelector does
+    auto reachable = [&](const VectorDIM& start) {
+        std::vector<Index> start_indexes = grid.getNeighbors(start);
+        start_indexes.push_back(grid.getIndex(start));
+
+        std::vector<Label> labels;
+        for(const Index& idx: start_indexes) {
+            if(rlss::internal::segmentValid<double, 2U>(
+                    grid, workspace, start, idx, collision_shape)) {
+                labels.push_back(*components.label(idx));
+            }
+        }
+
+        UnorderedIndexSet result;
+        for(long long int i = -1; i <= 15; i++) {
+            for(long long int j = -1; j <= 15; j++) {
+                std::optional<Label> label = components.label(Index(i, j));
+                if(label
+                   && std::find(labels.begin(), labels.end(), *label)
+                        != labels.end()) {
+                    result.insert(Index(i, j));
+                }
+            }
+        }
+        return result;
+    };
+
+    grid.setOccupancy(Index(5, 5));
+    grid.setOccupancy(Index(5, 8));
+    grid.setOccupancy(Index(11, 12));
+
+    components.update(grid);
+
+    for(const VectorDIM& start: {
+            VectorDIM(1.2, 5), VectorDIM(6.1, 6.1), VectorDIM(2.6, 0.4)}) {
+        REQUIRE(reachable(start) == rlss::internal::BFS<double, 2U>(
+                start, grid, workspace, collision_shape));
+    }
+
+    REQUIRE(components.connected(Index(1, 1), Index(12, 1)));
+    REQUIRE(!components.connected(Index(1, 1), Index(5, 5)));
+
+    grid.setOccupancy(Index(7, 9));
+    grid.setOccupancy(Index(8, 10));
+    grid.setOccupancy(Index(5, 2));
+
+    components.update(grid);
+
+    for(const VectorDIM& start: {
+            VectorDIM(1.2, 5), VectorDIM(6.1, 6.1), VectorDIM(2.6, 0.4)}) {
+        REQUIRE(reachable(start) == rlss::internal::BFS<double, 2U>(
+                start, grid, workspace, collision_shape));
+    }
+
+    REQUIRE(!components.connected(Index(1, 1), Index(12, 1)));
+
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<long long int> dist(0, 13);
+    for(int trial = 0; trial < 5; trial++) {
+        for(int i = 0; i < 8; i++) {
+            grid.setOccupancy(Index(dist(gen), dist(gen)));
+        }
+
+        components.update(grid);
+
+        VectorDIM start = grid.getCenter(Index(dist(gen), dist(gen)));
+        REQUIRE(reachable(start) == rlss::internal::BFS<double, 2U>(
+                start, grid, workspace, collision_shape));
+    }
+    // a grid constructed in the storage of a destroyed one, with the same
+    // number of changes, is not mistaken for it
+    std::optional<OccupancyGrid> reused;
+    reused.emplace(Coordinate(0.5, 0.5));
+    reused->setOccupancy(Index(3, 3));
+    components.update(*reused);
+    REQUIRE(!components.connected(Index(1, 1), Index(3, 3)));
+    REQUIRE(components.connected(Index(1, 1), Index(3, 9)));
+
+    reused.emplace(Coordinate(0.5, 0.5));
+    reused->setOccupancy(Index(3, 9));
+    components.update(*reused);
+    REQUIRE(components.connected(Index(1, 1), Index(3, 3)));
+    REQUIRE(!components.connected(Index(1, 1), Index(3, 9)));
+}
@@ -0,0 +1,274 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/JSONBuilder.hpp>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace {
+nlohmann::json roundTrip(const nlohmann::json& json) {
+    std::vector<std::uint8_t> bytes;
+    rlss::internal::jsonbuilder::writeCBOR(json, bytes);
+    return nlohmann::json::from_cbor(bytes);
+}
+
+bool containsObject(const nlohmann::json& json) {
+    if(json.is_object()) {
+        return true;
+    }
+    if(json.is_array()) {
+        for(const auto& item: json) {
+            if(containsObject(item)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+nlohmann::json vec(double x, double y) {
+    return nlohmann::json::array({x, y});
+}
+
+// document in the shape JSONBuilder<double, 2> produces
+nlohmann::json builderDocument() {
+    nlohmann::json document;
+    document["robot_count"] = 2;
+    document["frame_dt"] = 0.01;
+    document["robot_shapes"] = nlohmann::json::array();
+    for(int i = 0; i < 2; i++) {
+        nlohmann::json shape;
+        shape["robot_id"] = i;
+        shape["shape"]["min"] = vec(-0.1, -0.1);
+        shape["shape"]["max"] = vec(0.1, 0.1);
+        document["robot_shapes"].push_back(shape);
+    }
+
+    nlohmann::json piece;
+    piece["max_parameter"] = 1.5;
+    piece["type"] = "bezier";
+    piece["controlpoints"] = nlohmann::json::array(
+            {vec(0.1, -0.2), vec(0.3, -0.4), vec(0.5, -0.6)});
+
+    nlohmann::json first;
+    first["step"] = 0;
+    first["obstacles"].push_back({{"min", vec(-1, -2)}, {"max", vec(1, 2)}});
+    first["robot_positions"].push_back(
+            {{"robot_id", 1}, {"position", vec(0.7, -0.9)}});
+    nlohmann::json traj;
+    traj["robot_id"] = 1;
+    traj["trajectory"].push_back(piece);
+    traj["discrete_path"] = nlohmann::json::array({vec(0, 0), vec(1, 1)});
+    first["trajectories"].push_back(traj);
+    nlohmann::json hp;
+    hp["piece_id"] = 0;
+    hp["hyperplane"]["normal"] = vec(0.6, 0.8);
+    hp["hyperplane"]["distance"] = -2.5;
+    nlohmann::json robot_hps;
+    robot_hps["robot_id"] = 0;
+    robot_hps["hyperplanes"].push_back(hp);
+    first["hyperplanes"].push_back(robot_hps);
+
+    nlohmann::json second;
+    second["step"] = 1;
+    second["robot_positions"].push_back(
+            {{"robot_id", 0}, {"position", vec(0.25, 0.5)}});
+    second["robot_positions"].push_back(
+            {{"robot_id", 1}, {"position", vec(-0.3, 1.1)}});
+
+    document["frames"] = nlohmann::json::array({first, second});
+    return document;
+}
+}
+
+TEST_CASE("cbor writer", "[JSONBuilder]") {
+    SECTION("integers round trip") {
+        const std::vector<std::int64_t> values{
+            0, 23, 24, 255, 256, 65535, 65536, 4294967295LL, 4294967296LL,
+            -1, -24, -25, -256, -257, -65536, -65537, -4294967296LL,
+            -4294967297LL, std::numeric_limits<std::int64_t>::min(),
+            std::numeric_limits<std::int64_t>::max()
+        };
+        for(std::int64_t value: values) {
+            nlohmann::json json = value;
+            nlohmann::json decoded = roundTrip(json);
+            REQUIRE(decoded.is_number_integer());
+            REQUIRE(decoded.get<std::int64_t>() == value);
+        }
+
+        nlohmann::json json = std::numeric_limits<std::uint64_t>::max();
+        REQUIRE(roundTrip(json).get<std::uint64_t>()
+                == std::numeric_limits<std::uint64_t>::max());
+    }
+
+    SECTION("floats are narrowed to single precision") {
+        const std::vector<double> values{
+            0.1, -2.5, 1e-30, 3.0e20, -0.0, 0.0
+        };
+        for(double value: values) {
+            nlohmann::json json = value;
+            std::vector<std::uint8_t> bytes;
+            rlss::internal::jsonbuilder::writeCBOR(json, bytes);
+            REQUIRE(bytes.size() == 5);
+            REQUIRE(bytes[0] == 0xFA);
+            nlohmann::json decoded = nlohmann::json::from_cbor(bytes);
+            REQUIRE(decoded.get<double>()
+                    == static_cast<double>(static_cast<float>(value)));
+        }
+        REQUIRE(roundTrip(0.1).get<double>() != 0.1);
+
+        nlohmann::json nan = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(std::isnan(roundTrip(nan).get<double>()));
+    }
+
+    SECTION("builder document round trips") {
+        nlohmann::json document = builderDocument();
+        document["name"] = "vis";
+        document["flags"] = nlohmann::json::array({true, false, nullptr});
+        nlohmann::json decoded = roundTrip(document);
+
+        REQUIRE(decoded.size() == document.size());
+        REQUIRE(decoded["name"] == "vis");
+        REQUIRE(decoded["flags"] == document["flags"]);
+        REQUIRE(decoded["robot_count"] == 2);
+        REQUIRE(decoded["robot_shapes"][1]["robot_id"] == 1);
+        REQUIRE(decoded["frames"].size() == 2);
+
+        const nlohmann::json& piece
+                = decoded["frames"][0]["trajectories"][0]["trajectory"][0];
+        REQUIRE(piece["type"] == "bezier");
+        REQUIRE(piece["max_parameter"].get<double>() == 1.5);
+        REQUIRE(piece["controlpoints"].size() == 3);
+        REQUIRE(piece["controlpoints"][2][1].get<double>()
+                == static_cast<float>(-0.6));
+
+        const nlohmann::json& hp
+                = decoded["frames"][0]["hyperplanes"][0]["hyperplanes"][0];
+        REQUIRE(hp["piece_id"] == 0);
+        REQUIRE(hp["hyperplane"]["distance"].get<double>() == -2.5);
+        REQUIRE(hp["hyperplane"]["normal"][0].get<double>()
+                == static_cast<float>(0.6));
+    }
+}
+
+TEST_CASE("packed document", "[JSONBuilder]") {
+    const nlohmann::json packed = roundTrip(
+            rlss::internal::jsonbuilder::pack(builderDocument(), 2));
+
+    REQUIRE(packed["encoding"] == "packed");
+    REQUIRE(packed["dimension"] == 2);
+    REQUIRE(packed["frame_layout"] == nlohmann::json::array({
+        "step", "robot_positions", "trajectories", "obstacles", "hyperplanes"
+    }));
+    REQUIRE(packed["robot_count"] == 2);
+    REQUIRE(packed["robot_shapes"][0]["shape"]["max"][0].get<double>()
+            == static_cast<float>(0.1));
+
+    SECTION("frames repeat no keys") {
+        REQUIRE(packed["frames"].size() == 2);
+        for(const auto& frame: packed["frames"]) {
+            REQUIRE(frame.size() == 5);
+            REQUIRE_FALSE(containsObject(frame));
+        }
+    }
+
+    SECTION("positions are float arrays indexed by robot id") {
+        const nlohmann::json& first = packed["frames"][0][1];
+        REQUIRE(first.size() == 4);
+        REQUIRE(std::isnan(first[0].get<double>()));
+        REQUIRE(std::isnan(first[1].get<double>()));
+        REQUIRE(first[2].get<double>() == static_cast<float>(0.7));
+        REQUIRE(first[3].get<double>() == static_cast<float>(-0.9));
+
+        const nlohmann::json& second = packed["frames"][1][1];
+        REQUIRE(second == nlohmann::json::array({
+            static_cast<float>(0.25), static_cast<float>(0.5),
+            static_cast<float>(-0.3), static_cast<float>(1.1)
+        }));
+    }
+
+    SECTION("fields a frame does not set are null") {
+        const nlohmann::json& second = packed["frames"][1];
+        REQUIRE(second[0] == 1);
+        REQUIRE(second[2].is_null());
+        REQUIRE(second[3].is_null());
+        REQUIRE(second[4].is_null());
+    }
+
+    SECTION("trajectories, obstacles and hyperplanes are flattened") {
+        const nlohmann::json& first = packed["frames"][0];
+
+        const nlohmann::json& traj = first[2][0];
+        REQUIRE(traj[0] == 1);
+        REQUIRE(traj[1].size() == 1);
+        REQUIRE(traj[1][0][0].get<double>() == 1.5);
+        REQUIRE(traj[1][0][1].size() == 6);
+        REQUIRE(traj[1][0][1][5].get<double>() == static_cast<float>(-0.6));
+        REQUIRE(traj[2] == nlohmann::json::array({0, 0, 1, 1}));
+
+        REQUIRE(first[3] == nlohmann::json::array({-1, -2, 1, 2}));
+
+        const nlohmann::json& hps = first[4][0];
+        REQUIRE(hps[0] == 0);
+        REQUIRE(hps[1] == nlohmann::json::array({0}));
+        REQUIRE(hps[2] == nlohmann::json::array({
+            static_cast<float>(0.6), static_cast<float>(0.8), -2.5f
+        }));
+    }
+
+    SECTION("packed document is smaller") {
+        std::vector<std::uint8_t> plain;
+        std::vector<std::uint8_t> packed_bytes;
+        rlss::internal::jsonbuilder::writeCBOR(builderDocument(), plain);
+        rlss::internal::jsonbuilder::writeCBOR(
+                rlss::internal::jsonbuilder::pack(builderDocument(), 2),
+                packed_bytes);
+        REQUIRE(packed_bytes.size() < plain.size());
+    }
+}
+
+#ifdef ENABLE_RLSS_JSON_BUILDER
+TEST_CASE("json builder saves packed cbor", "[JSONBuilder]") {
+    using JSONBuilder = rlss::internal::JSONBuilder<double, 2>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2>;
+    using AlignedBox = rlss::internal::AlignedBox<double, 2>;
+    const std::string filename = "json_builder_test.cbor";
+
+    JSONBuilder builder;
+    builder.setRobotCount(2);
+    builder.setRobotShape(0, AlignedBox(VectorDIM(-0.1, -0.1),
+                                        VectorDIM(0.1, 0.1)));
+    builder.setRobotShape(1, AlignedBox(VectorDIM(-0.2, -0.2),
+                                        VectorDIM(0.2, 0.2)));
+    builder.setFrameDt(0.01);
+    builder.setRobotPositionInCurrentFrame(0, VectorDIM(1.25, -3.5));
+    builder.setRobotPositionInCurrentFrame(1, VectorDIM(-0.1, 0.2));
+    builder.nextFrame();
+    builder.setRobotPositionInCurrentFrame(1, VectorDIM(-0.2, 0.4));
+    builder.nextFrame();
+    builder.save(filename, rlss::internal::jsonbuilder::Format::PackedCBOR);
+
+    std::ifstream file(filename, std::ios_base::binary);
+    std::vector<std::uint8_t> bytes(
+            (std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+    nlohmann::json packed = nlohmann::json::from_cbor(bytes);
+
+    REQUIRE(packed["encoding"] == "packed");
+    REQUIRE(packed["frame_dt"].get<double>() == static_cast<float>(0.01));
+    REQUIRE(packed["robot_shapes"][1]["shape"]["min"][0].get<double>()
+            == static_cast<float>(-0.2));
+    REQUIRE(packed["frames"].size() == 2);
+    REQUIRE(packed["frames"][0][0] == 0);
+    REQUIRE(packed["frames"][0][1] == nlohmann::json::array({
+        1.25f, -3.5f, static_cast<float>(-0.1), static_cast<float>(0.2)
+    }));
+    REQUIRE(packed["frames"][1][0] == 1);
+    REQUIRE(std::isnan(packed["frames"][1][1][0].get<double>()));
+    REQUIRE(packed["frames"][1][1][3].get<double>()
+            == static_cast<float>(0.4));
+}
+#endif
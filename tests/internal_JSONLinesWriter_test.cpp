@@ -0,0 +1,104 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/JSONLinesWriter.hpp>
+#include <rlss/internal/Statistics.hpp>
+#include <fstream>
+#include <thread>
+
+namespace {
+std::vector<nlohmann::json> readLines(const std::string& filename) {
+    std::vector<nlohmann::json> result;
+    std::ifstream file(filename);
+    std::string line;
+    while(std::getline(file, line)) {
+        result.push_back(nlohmann::json::parse(line));
+    }
+    return result;
+}
+}
+
+TEST_CASE("json lines writer", "[JSONLinesWriter]") {
+    using JSONLinesWriter = rlss::internal::JSONLinesWriter;
+    const std::string filename = "json_lines_writer_test.jsonl";
+
+    SECTION("records of one thread are written in order") {
+        JSONLinesWriter writer(filename);
+        for(int i = 0; i < 100; i++) {
+            nlohmann::json record;
+            record["index"] = i;
+            writer.write(record);
+        }
+        writer.flush();
+
+        std::vector<nlohmann::json> lines = readLines(filename);
+        REQUIRE(lines.size() == 100);
+        for(int i = 0; i < 100; i++) {
+            REQUIRE(lines[i]["index"] == i);
+        }
+    }
+
+    SECTION("records of several threads are all written") {
+        {
+            JSONLinesWriter writer(filename);
+            std::vector<std::thread> threads;
+            for(int t = 0; t < 4; t++) {
+                threads.emplace_back([&writer, t]() {
+                    for(int i = 0; i < 250; i++) {
+                        nlohmann::json record;
+                        record["thread"] = t;
+                        record["index"] = i;
+                        writer.write(record);
+                    }
+                });
+            }
+            for(std::thread& thread: threads) {
+                thread.join();
+            }
+        }
+
+        std::vector<nlohmann::json> lines = readLines(filename);
+        REQUIRE(lines.size() == 1000);
+        std::vector<int> next_index(4, 0);
+        for(const nlohmann::json& line: lines) {
+            int t = line["thread"];
+            REQUIRE(line["index"] == next_index[t]);
+            next_index[t]++;
+        }
+    }
+
+    REQUIRE_THROWS_AS(JSONLinesWriter("no_such_directory/file.jsonl"),
+                      std::domain_error);
+}
+
+#ifdef ENABLE_RLSS_STATISTICS
+TEST_CASE("statistics streaming", "[JSONLinesWriter]") {
+    using StatisticsStorage = rlss::internal::StatisticsStorage<double>;
+    const std::string filename = "statistics_streaming_test.jsonl";
+
+    {
+        auto writer
+            = std::make_shared<rlss::internal::JSONLinesWriter>(filename);
+        StatisticsStorage storage;
+        storage.setKeepRecords(false);
+        storage.streamTo(writer, 3);
+
+        StatisticsStorage::DurationStatistics_ ds;
+        ds.setPlanningDuration(42);
+        storage.add(ds);
+        StatisticsStorage::SuccessFailureStatistics_ sf;
+        sf.setPlanningSuccessFail(true);
+        storage.add(sf);
+
+        REQUIRE(storage.durationStatistics().empty());
+    }
+
+    std::vector<nlohmann::json> lines = readLines(filename);
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines[0]["type"] == "duration_statistics");
+    REQUIRE(lines[0]["source"] == 3);
+    REQUIRE(lines[0]["planning_duration"] == 42);
+    REQUIRE(lines[1]["type"] == "success_failure_statistics");
+    REQUIRE(lines[1]["source"] == 3);
+}
+#endif
@@ -0,0 +1,79 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <rlss/internal/MonotonicArena.hpp>
+#include <cstdint>
+
+TEST_CASE("arena backed helpers match the allocating ones", "[MonotonicArena]") {
+    using VectorDIM = rlss::internal::VectorDIM<double, 3U>;
+    using AlignedBox = rlss::internal::AlignedBox<double, 3U>;
+    using StdVectorVectorDIM = rlss::internal::StdVectorVectorDIM<double, 3U>;
+    using PmrVectorVectorDIM = rlss::internal::PmrVectorVectorDIM<double, 3U>;
+
+    rlss::internal::MonotonicArena arena(256);
+
+    StdVectorVectorDIM segments {
+        VectorDIM(0, 0, 0),
+        VectorDIM(4, 0, 0),
+        VectorDIM(4, 1, 2)
+    };
+    AlignedBox box(VectorDIM(-1, 1, 2), VectorDIM(3, 2, 1));
+
+    std::size_t blocks_after_first_use = 0;
+    std::size_t capacity_after_first_use = 0;
+
+    for(int round = 0; round < 3; round++) {
+        {
+            PmrVectorVectorDIM corners(&arena);
+            rlss::internal::cornerPoints<double, 3U>(box, corners);
+            StdVectorVectorDIM expected_corners
+                    = rlss::internal::cornerPoints<double, 3U>(box);
+            REQUIRE(std::equal(corners.begin(), corners.end(),
+                               expected_corners.begin(),
+                               expected_corners.end()));
+
+            PmrVectorVectorDIM fixed(&arena);
+            rlss::internal::firstSegmentFix<double, 3U>(segments, fixed);
+            StdVectorVectorDIM expected_fixed
+                    = rlss::internal::firstSegmentFix<double, 3U>(segments);
+            REQUIRE(std::equal(fixed.begin(), fixed.end(),
+                               expected_fixed.begin(),
+                               expected_fixed.end()));
+
+            PmrVectorVectorDIM split(&arena);
+            rlss::internal::bestSplitSegments<double, 3U>(segments, 7, split);
+            StdVectorVectorDIM expected_split
+                    = rlss::internal::bestSplitSegments<double, 3U>(
+                            segments, 7);
+            REQUIRE(split.size() == 8);
+            REQUIRE(std::equal(split.begin(), split.end(),
+                               expected_split.begin(),
+                               expected_split.end()));
+
+            PmrVectorVectorDIM interpolated(&arena);
+            rlss::internal::linearInterpolate<double, 3U>(
+                    segments[0], segments[1], 5, interpolated);
+            REQUIRE(interpolated.size() == 5);
+            REQUIRE(interpolated[2] == VectorDIM(2, 0, 0));
+
+            for(const VectorDIM& pt: split) {
+                REQUIRE(reinterpret_cast<std::uintptr_t>(&pt)
+                        % alignof(VectorDIM) == 0);
+            }
+        }
+
+        if(round == 0) {
+            REQUIRE(arena.numBlocks() > 1);
+        } else {
+            // everything fits in the merged block
+            REQUIRE(arena.numBlocks() == 1);
+            REQUIRE(arena.capacity() == capacity_after_first_use);
+        }
+
+        arena.reset();
+        REQUIRE(arena.numBlocks() == 1);
+        blocks_after_first_use = arena.numBlocks();
+        capacity_after_first_use = arena.capacity();
+    }
+
+    REQUIRE(blocks_after_first_use == 1);
+}
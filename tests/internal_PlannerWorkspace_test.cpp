@@ -0,0 +1,97 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/PlannerWorkspace.hpp>
+
+namespace {
+
+std::size_t construction_count = 0;
+
+class CountingSolver: public rlss::internal::QPSolver<double> {
+public:
+    using Base = rlss::internal::QPSolver<double>;
+
+    CountingSolver(): Base("counting") {
+        construction_count++;
+    }
+
+    void setFeasibilityTolerance(double tolerance) override {
+
+    }
+
+protected:
+    OptReturnType initImpl(const Problem& problem, Vector& soln) override {
+        return OptReturnType::Optimal;
+    }
+
+    OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) override {
+        return OptReturnType::Optimal;
+    }
+};
+
+}
+
+TEST_CASE("planner workspace reuses its objects", "[PlannerWorkspace]") {
+    rlss::internal::QPSolverRegistry<double>::instance().registerSolver(
+        "counting",
+        []() {
+            return std::unique_ptr<rlss::internal::QPSolver<double>>(
+                    new CountingSolver());
+        }
+    );
+
+    rlss::internal::PlannerWorkspace<double> workspace;
+    const std::string name = "counting";
+    std::vector<double> durations {0.5, 1, 1.5, 2};
+
+    auto first = workspace.solver(name);
+    auto concurrent = workspace.solver(name, 1);
+    REQUIRE(construction_count == 2);
+    REQUIRE(first != concurrent);
+    REQUIRE(workspace.numSolvers() == 2);
+
+    std::vector<const double*> buffer_data;
+    auto use = [&]() {
+        auto solver = workspace.solver(name);
+        auto concurrent_solver = workspace.solver(name, 1);
+        std::vector<std::vector<double>>& buffers
+                = workspace.durationBuffers(3);
+        buffer_data.clear();
+        for(std::size_t i = 0; i < 3; i++) {
+            buffers[i].assign(durations.begin(), durations.end());
+            buffer_data.push_back(buffers[i].data());
+        }
+        return solver == first && concurrent_solver == concurrent;
+    };
+
+    // first use sizes the buffers
+    REQUIRE(use());
+    const std::vector<const double*> first_buffer_data = buffer_data;
+
+    // later uses get the same solvers and buffers, which keep their storage
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(use());
+        REQUIRE(buffer_data == first_buffer_data);
+    }
+    REQUIRE(construction_count == 2);
+    REQUIRE(workspace.durationBuffers(2).size() == 3);
+
+    // problem copies stay in their slots
+    QPWrappers::Problem<double> problem(3), other_problem(4);
+    const auto& problem_copy = workspace.problemCopy(problem);
+    const auto& other_copy = workspace.problemCopy(other_problem, 1);
+    for(int i = 0; i < 3; i++) {
+        REQUIRE(&workspace.problemCopy(problem) == &problem_copy);
+    }
+    REQUIRE(&workspace.problemCopy(other_problem, 1) == &other_copy);
+    REQUIRE(problem_copy.num_vars() == 3);
+    REQUIRE(other_copy.num_vars() == 4);
+
+    rlss::internal::PlannerWorkspace<double> copy(workspace);
+    REQUIRE(copy.numSolvers() == 0);
+    REQUIRE(copy.solver(name) != first);
+}
@@ -0,0 +1,143 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/QPSolver.hpp>
+#include <rlss/internal/SVM.hpp>
+#include <algorithm>
+
+namespace {
+
+// returns a fixed solution for every problem
+class FixedSolver: public rlss::internal::QPSolver<double> {
+public:
+    using Base = rlss::internal::QPSolver<double>;
+
+    FixedSolver(const std::string& name, const Vector& solution)
+        : Base(name),
+          m_solution(solution)
+    {
+
+    }
+
+    void setFeasibilityTolerance(double tolerance) override {
+
+    }
+
+protected:
+    OptReturnType initImpl(const Problem& problem, Vector& soln) override {
+        soln = m_solution;
+        return OptReturnType::Optimal;
+    }
+
+    OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) override {
+        return this->initImpl(problem, soln);
+    }
+
+private:
+    Vector m_solution;
+};
+
+}
+
+// engine whose solves can be stopped
+class StoppableEngine {
+public:
+    using Vector = QPWrappers::Problem<double>::Vector;
+
+    void setFeasibilityTolerance(double tolerance) {
+
+    }
+
+    void requestStop() {
+        stop_requests++;
+    }
+
+    QPWrappers::OptReturnType init(
+            const QPWrappers::Problem<double>& problem,
+            Vector& soln
+    ) {
+        return QPWrappers::OptReturnType::Unknown;
+    }
+
+    QPWrappers::OptReturnType next(
+            const QPWrappers::Problem<double>& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) {
+        return QPWrappers::OptReturnType::Unknown;
+    }
+
+    static int stop_requests;
+};
+
+int StoppableEngine::stop_requests = 0;
+
+TEST_CASE("qp solver registry", "[QPSolver]") {
+    using Registry = rlss::internal::QPSolverRegistry<double>;
+    Registry& registry = Registry::instance();
+
+    for(const std::string& name: {"qpoases", "osqp"}) {
+        REQUIRE(registry.contains(name));
+        REQUIRE(registry.create(name)->name() == name);
+    }
+#ifdef ENABLE_RLSS_CPLEX
+    REQUIRE(registry.contains("cplex"));
+#else
+    REQUIRE(!registry.contains("cplex"));
+#endif
+#ifdef ENABLE_RLSS_GUROBI
+    REQUIRE(registry.contains("gurobi"));
+#else
+    REQUIRE(!registry.contains("gurobi"));
+#endif
+
+    REQUIRE(!registry.contains("fixed"));
+    REQUIRE_THROWS_AS(registry.create("fixed"), std::domain_error);
+
+    rlss::QPSolverSelection selection;
+    REQUIRE_NOTHROW(registry.validate(selection));
+    selection.svm = "fixed";
+    REQUIRE_THROWS_AS(registry.validate(selection), std::domain_error);
+
+    FixedSolver::Vector solution(3);
+    solution << 1, -2, 0.5;
+    registry.registerSolver("fixed", [solution]() {
+        return std::unique_ptr<rlss::internal::QPSolver<double>>(
+                new FixedSolver("fixed", solution));
+    });
+
+    REQUIRE(registry.contains("fixed"));
+    REQUIRE_NOTHROW(registry.validate(selection));
+
+    std::vector<std::string> names = registry.names();
+    REQUIRE(std::is_sorted(names.begin(), names.end()));
+    REQUIRE(std::find(names.begin(), names.end(), "fixed") != names.end());
+
+    rlss::internal::StdVectorVectorDIM<double, 2U> f {{2, 1}, {3, 1}};
+    rlss::internal::StdVectorVectorDIM<double, 2U> s {{-1, -1}, {-2, -3}};
+    rlss::internal::SolverDurations<double> durations;
+    rlss::internal::Hyperplane<double, 2U> hp
+            = rlss::internal::svm<double, 2U>(f, s, "fixed", &durations);
+
+    REQUIRE(hp.normal()(0) == 1);
+    REQUIRE(hp.normal()(1) == -2);
+    REQUIRE(hp.offset() == 0.5);
+    REQUIRE(durations.size() == 1);
+    REQUIRE(durations[0].first == "fixed");
+    REQUIRE(durations[0].second >= 0);
+}
+
+TEST_CASE("qp solver stop support", "[QPSolver]") {
+    rlss::internal::QPEngineSolver<double, StoppableEngine> stoppable(
+            "stoppable");
+    REQUIRE(stoppable.supportsStop());
+    stoppable.requestStop();
+    REQUIRE(StoppableEngine::stop_requests == 1);
+
+    REQUIRE(!rlss::internal::createQPSolver<double>("qpoases")->supportsStop());
+    REQUIRE(!FixedSolver("fixed", FixedSolver::Vector()).supportsStop());
+}
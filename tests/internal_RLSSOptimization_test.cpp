@@ -0,0 +1,143 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/RLSSOptimization.hpp>
+#include <rlss/CollisionShapes/AlignedBoxCollisionShape.hpp>
+#include <rlss/OccupancyGrid.hpp>
+#include <memory>
+
+TEST_CASE("free box is inflated against the grid", "[internal::inflateFreeBox]") {
+    using OccupancyGrid = rlss::OccupancyGrid<double, 2U>;
+    using AlignedBox = typename OccupancyGrid::AlignedBox;
+    using VectorDIM = typename OccupancyGrid::VectorDIM;
+    using Coordinate = OccupancyGrid::Coordinate;
+
+    OccupancyGrid grid(Coordinate(0.5, 0.5));
+    // wall at x in [2.5, 3] for y in [0, 5]
+    grid.addObstacle(AlignedBox(VectorDIM(2.6, 0.1), VectorDIM(2.9, 4.9)));
+    // block at y in [1.5, 2] for x in [0, 1]
+    grid.addObstacle(AlignedBox(VectorDIM(0.1, 1.6), VectorDIM(0.9, 1.9)));
+
+    AlignedBox workspace(VectorDIM(0, 0), VectorDIM(10, 10));
+    AlignedBox box(VectorDIM(1.2, 2.2), VectorDIM(1.8, 2.4));
+
+    AlignedBox corridor = rlss::internal::inflateFreeBox<double, 2U>(
+        grid, workspace, box, 1.0
+    );
+
+    REQUIRE(corridor.contains(box));
+    REQUIRE(!grid.isOccupied(AlignedBox(
+        corridor.min().array() + 1e-6, corridor.max().array() - 1e-6)));
+
+    // x is limited by the wall on the right and by the distance on the left,
+    // y is limited by the block once x reaches it, and by the distance
+    REQUIRE(corridor.min()(0) == Approx(0.2));
+    REQUIRE(corridor.max()(0) == Approx(2.5));
+    REQUIRE(corridor.min()(1) == Approx(2.0));
+    REQUIRE(corridor.max()(1) == Approx(3.4));
+
+    auto colshape = std::make_shared<rlss::AlignedBoxCollisionShape<double, 2U>>(
+        AlignedBox(VectorDIM(-0.1, -0.1), VectorDIM(0.1, 0.1))
+    );
+
+    AlignedBox bounds(box.min().array() - 1.0, box.max().array() + 1.0);
+    bounds = bounds.intersection(workspace);
+
+    std::vector<rlss::internal::Hyperplane<double, 2U>> hps
+        = rlss::internal::corridorHyperplanes<double, 2U>(
+            corridor, bounds, colshape
+        );
+
+    // only the faces that are blocked by obstacles
+    REQUIRE(hps.size() == 2);
+    REQUIRE(hps[0].normal() == VectorDIM(1, 0));
+    REQUIRE(hps[0].offset() == Approx(-2.4));
+    REQUIRE(hps[1].normal() == VectorDIM(0, -1));
+    REQUIRE(hps[1].offset() == Approx(2.1));
+}
+
+TEST_CASE("previous curve is shifted onto the new pieces",
+          "[internal::warmStartDecisionVariables]") {
+    using PiecewiseCurve = splx::PiecewiseCurve<double, 2U>;
+    using Bezier = splx::Bezier<double, 2U>;
+    using QPGenerator = splx::PiecewiseCurveQPGenerator<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+
+    Bezier bezier(4.0);
+    bezier.appendControlPoint(VectorDIM(0, 0));
+    bezier.appendControlPoint(VectorDIM(2, 3));
+    bezier.appendControlPoint(VectorDIM(5, 1));
+    PiecewiseCurve previous_curve;
+    previous_curve.addPiece(bezier);
+
+    QPGenerator qpgen;
+    qpgen.addBezier(4, 0);
+    qpgen.addBezier(4, 0);
+    qpgen.setPieceMaxParameters({1.0, 1.5});
+
+    rlss::internal::StdVectorVectorDIM<double, 2U> segments {
+        VectorDIM(1, 1), VectorDIM(2, 2), VectorDIM(3, 1)
+    };
+    auto segments_dvars = qpgen.getDVarsForSegments(segments);
+
+    auto dvars = rlss::internal::warmStartDecisionVariables<double, 2U>(
+        qpgen, segments_dvars, previous_curve, 0.7
+    );
+    REQUIRE(dvars);
+    REQUIRE(dvars->rows() == segments_dvars.rows());
+
+    // the quadratic previous curve is represented exactly by cubic pieces
+    PiecewiseCurve warm_curve = qpgen.extractCurve(*dvars);
+    for(double t = 0; t <= 2.5; t += 0.125) {
+        REQUIRE((warm_curve.eval(t, 0) - previous_curve.eval(t + 0.7, 0))
+                    .norm() < 1e-9);
+    }
+
+    // after the previous curve ends, the warm start stays at its end point
+    dvars = rlss::internal::warmStartDecisionVariables<double, 2U>(
+        qpgen, segments_dvars, previous_curve, 3.0
+    );
+    REQUIRE(dvars);
+    warm_curve = qpgen.extractCurve(*dvars);
+    REQUIRE((warm_curve.eval(2.5, 0) - VectorDIM(5, 1)).norm() < 1e-9);
+
+    REQUIRE(!rlss::internal::warmStartDecisionVariables<double, 2U>(
+        qpgen, segments_dvars, previous_curve, 4.5
+    ));
+}
+
+TEST_CASE("robot pair hyperplane negated for the partner",
+          "[internal::robot_safety_hyperplanes]") {
+    using AlignedBox = rlss::internal::AlignedBox<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+    using Hyperplane = rlss::internal::Hyperplane<double, 2U>;
+    using CollisionShape = rlss::CollisionShape<double, 2U>;
+    using AlignedBoxCollisionShape
+            = rlss::AlignedBoxCollisionShape<double, 2U>;
+
+    std::shared_ptr<CollisionShape> colshape
+            = std::make_shared<AlignedBoxCollisionShape>(
+                    AlignedBox(VectorDIM(-0.5, -0.25), VectorDIM(0.5, 0.25)));
+
+    VectorDIM first_position(0, 0);
+    VectorDIM second_position(2, 1.5);
+    AlignedBox first_box = colshape->boundingBox(first_position);
+    AlignedBox second_box = colshape->boundingBox(second_position);
+
+    Hyperplane first_hp = rlss::internal::robot_safety_hyperplanes<double, 2U>(
+            first_position, {second_box}, colshape)[0];
+    Hyperplane second_hp = rlss::internal::robot_safety_hyperplanes<double, 2U>(
+            second_position, {first_box}, colshape)[0];
+
+    Hyperplane pair_hp = rlss::internal::svm<double, 2U>(
+            rlss::internal::cornerPoints<double, 2U>(first_box),
+            rlss::internal::cornerPoints<double, 2U>(second_box));
+    Hyperplane negated_pair_hp(-pair_hp.normal(), -pair_hp.offset());
+
+    REQUIRE(first_hp.isApprox(
+            rlss::internal::shiftHyperplane<double, 2U>(
+                    first_position, first_box, pair_hp), 1e-6));
+    REQUIRE(second_hp.isApprox(
+            rlss::internal::shiftHyperplane<double, 2U>(
+                    second_position, second_box, negated_pair_hp), 1e-6));
+}
@@ -2,7 +2,9 @@
 #include "catch.hpp"
 
 #include <rlss/internal/SVM.hpp>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 TEST_CASE("SVM in 2D", "internal::svm") {
     using StdVectorVectorDIM2 = rlss::internal::StdVectorVectorDIM<double, 2U>;
@@ -47,4 +49,83 @@ TEST_CASE("SVM in 3D", "internal::svm") {
     Hyperplane3 shp {VectorDIM3 {2,0,0}, -3};
 
     REQUIRE(shp.isApprox(svmhp, 1e-9));
-}
\ No newline at end of file
+}
+namespace {
+
+// records the time limit of its solves
+class TimeLimitRecordingSolver: public rlss::internal::QPSolver<double> {
+public:
+    using Base = rlss::internal::QPSolver<double>;
+
+    TimeLimitRecordingSolver(): Base("time_limit_recording") {
+
+    }
+
+    void setFeasibilityTolerance(double tolerance) override {
+
+    }
+
+    void setTimeLimit(double seconds) override {
+        m_time_limit = seconds;
+    }
+
+    double solveTimeLimit() const {
+        return m_solve_time_limit;
+    }
+
+protected:
+    OptReturnType initImpl(const Problem& problem, Vector& soln) override {
+        m_solve_time_limit = m_time_limit;
+        soln = Vector::Zero(problem.num_vars());
+        soln(0) = -1;
+        return OptReturnType::Optimal;
+    }
+
+    OptReturnType nextImpl(
+            const Problem& problem,
+            Vector& soln,
+            const Vector& initial_guess
+    ) override {
+        return this->initImpl(problem, soln);
+    }
+
+private:
+    double m_time_limit = std::numeric_limits<double>::infinity();
+    double m_solve_time_limit = 0;
+};
+
+}
+
+TEST_CASE("SVM solves use their own workspace solver", "internal::svm") {
+    using StdVectorVectorDIM2 = rlss::internal::StdVectorVectorDIM<double, 2U>;
+    using PlannerWorkspace = rlss::internal::PlannerWorkspace<double>;
+
+    rlss::internal::QPSolverRegistry<double>::instance().registerSolver(
+        "time_limit_recording",
+        []() {
+            return std::unique_ptr<rlss::internal::QPSolver<double>>(
+                    new TimeLimitRecordingSolver());
+        }
+    );
+
+    PlannerWorkspace workspace;
+    auto trajectory_solver = std::static_pointer_cast<TimeLimitRecordingSolver>(
+            workspace.solver(
+                "time_limit_recording", PlannerWorkspace::TrajectorySlot));
+    auto svm_solver = std::static_pointer_cast<TimeLimitRecordingSolver>(
+            workspace.solver("time_limit_recording", PlannerWorkspace::SvmSlot));
+    REQUIRE(trajectory_solver != svm_solver);
+
+    // a trajectory optimizer that used its solver left a short limit
+    trajectory_solver->setTimeLimit(1e-6);
+
+    StdVectorVectorDIM2 f {{2, 1}};
+    StdVectorVectorDIM2 s {{-1, -1}};
+    rlss::internal::svm<double, 2U>(
+            f, s, "time_limit_recording", nullptr, &workspace);
+
+    // the svm solved with its own solver, which the trajectory optimizer
+    // did not limit, and left the trajectory solver untouched
+    REQUIRE(std::isinf(svm_solver->solveTimeLimit()));
+    REQUIRE(trajectory_solver->solveTimeLimit() == 0);
+}
@@ -0,0 +1,48 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/SpatialHash.hpp>
+#include <random>
+
+TEST_CASE("spatial hash queries match brute force", "[SpatialHash]") {
+    using AlignedBox = rlss::internal::AlignedBox<double, 2U>;
+    using VectorDIM = rlss::internal::VectorDIM<double, 2U>;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> position(-20, 20);
+    std::uniform_real_distribution<double> extent(0.1, 3);
+
+    std::vector<AlignedBox> boxes;
+    for(int i = 0; i < 200; i++) {
+        VectorDIM min(position(gen), position(gen));
+        VectorDIM size(extent(gen), extent(gen));
+        boxes.emplace_back(min, min + size);
+    }
+
+    for(double cell_size: {0.5, 2.0, 7.0}) {
+        rlss::internal::SpatialHash<double, 2U> hash(cell_size);
+        for(std::size_t i = 0; i < boxes.size(); i++) {
+            hash.insert(i, boxes[i]);
+        }
+
+        std::vector<std::size_t> ids;
+        for(double distance: {0.0, 1.0, 4.5}) {
+            for(const AlignedBox& query: boxes) {
+                hash.query(query, distance, ids);
+
+                std::vector<std::size_t> expected;
+                for(std::size_t i = 0; i < boxes.size(); i++) {
+                    if(query.exteriorDistance(boxes[i]) <= distance) {
+                        expected.push_back(i);
+                    }
+                }
+                REQUIRE(ids == expected);
+                REQUIRE(hash.anyWithin(query, distance) == !expected.empty());
+            }
+        }
+    }
+
+    using SpatialHash = rlss::internal::SpatialHash<double, 2U>;
+    REQUIRE(!SpatialHash(1.0).anyWithin(boxes[0], 1.0));
+    REQUIRE_THROWS_AS(SpatialHash(0), std::domain_error);
+}
@@ -0,0 +1,67 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rlss/internal/ThreadPool.hpp>
+#include <numeric>
+#include <stdexcept>
+
+TEST_CASE("thread pool runs every iteration once", "[ThreadPool]") {
+    for(std::size_t thread_count: {1, 2, 4}) {
+        rlss::internal::ThreadPool pool(thread_count);
+        REQUIRE(pool.threadCount() == thread_count);
+
+        for(std::size_t count: {0, 1, 3, 100}) {
+            std::vector<int> calls(count, 0);
+            // several jobs in a row reuse the same threads
+            for(int job = 0; job < 5; job++) {
+                pool.parallelFor(count, [&](std::size_t i) {
+                    calls[i]++;
+                });
+            }
+            for(std::size_t i = 0; i < count; i++) {
+                REQUIRE(calls[i] == 5);
+            }
+        }
+    }
+}
+
+TEST_CASE("thread pool results do not depend on thread count",
+          "[ThreadPool]") {
+    auto run = [](std::size_t thread_count) {
+        rlss::internal::ThreadPool pool(thread_count);
+        std::vector<double> results(64);
+        pool.parallelFor(results.size(), [&](std::size_t i) {
+            double value = 0;
+            for(std::size_t k = 0; k <= i * 1000; k++) {
+                value += 1.0 / (k + 1);
+            }
+            results[i] = value;
+        });
+        return results;
+    };
+
+    std::vector<double> sequential = run(1);
+    REQUIRE(run(3) == sequential);
+    REQUIRE(run(8) == sequential);
+}
+
+TEST_CASE("thread pool rethrows exceptions of iterations", "[ThreadPool]") {
+    rlss::internal::ThreadPool pool(3);
+    std::vector<int> calls(20, 0);
+    REQUIRE_THROWS_AS(
+        pool.parallelFor(calls.size(), [&](std::size_t i) {
+            calls[i]++;
+            if(i == 7) {
+                throw std::domain_error("iteration failed");
+            }
+        }),
+        std::domain_error
+    );
+    REQUIRE(std::accumulate(calls.begin(), calls.end(), 0) == 20);
+
+    // pool is still usable
+    pool.parallelFor(calls.size(), [&](std::size_t i) {
+        calls[i]++;
+    });
+    REQUIRE(std::accumulate(calls.begin(), calls.end(), 0) == 40);
+}
@@ -2,6 +2,7 @@
 #include "catch.hpp"
 #include <rlss/internal/Util.hpp>
 #include <iostream>
+#include <random>
 
 TEST_CASE("Corner points are computed for 3D", "[internal::cornerPoints]") {
     using AlignedBox3 = rlss::internal::AlignedBox<double, 3U>;
@@ -35,4 +36,112 @@ TEST_CASE("Corner points are computed for 2D", "[internal::cornerPoints]") {
     REQUIRE(std::find(corners.begin(), corners.end(), VectorDIM2(-1, 2)) != corners.end());
     REQUIRE(std::find(corners.begin(), corners.end(), VectorDIM2(3, 1)) != corners.end());
     REQUIRE(std::find(corners.begin(), corners.end(), VectorDIM2(3, 2)) != corners.end());
-}
\ No newline at end of file
+}
+TEST_CASE("Dominated hyperplanes are pruned", "[internal::pruneDominatedHyperplanes]") {
+    using AlignedBox2 = rlss::internal::AlignedBox<double, 2U>;
+    using VectorDIM2 = rlss::internal::VectorDIM<double, 2U>;
+    using Hyperplane2 = rlss::internal::Hyperplane<double, 2U>;
+
+    AlignedBox2 box(VectorDIM2(0, 0), VectorDIM2(10, 10));
+
+    std::vector<Hyperplane2> hps;
+    hps.emplace_back(VectorDIM2(1, 0), -5);   // x <= 5
+    hps.emplace_back(VectorDIM2(2, 0), -12);  // x <= 6, looser
+    hps.emplace_back(VectorDIM2(1, 0), -5);   // duplicate
+    hps.emplace_back(VectorDIM2(0, 1), -20);  // y <= 20, inactive in box
+    hps.emplace_back(VectorDIM2(1, 0.01), -6); // near parallel, looser
+    hps.emplace_back(VectorDIM2(0, -1), 3);   // y >= 3
+    hps.emplace_back(VectorDIM2(1, 1), -12);  // x + y <= 12
+
+    std::vector<Hyperplane2> pruned
+        = rlss::internal::pruneDominatedHyperplanes<double, 2U>(hps, box);
+
+    REQUIRE(pruned.size() == 3);
+    REQUIRE(pruned[0].normal() == VectorDIM2(1, 0));
+    REQUIRE(pruned[0].offset() == -5);
+    REQUIRE(pruned[1].normal() == VectorDIM2(0, -1));
+    REQUIRE(pruned[2].normal() == VectorDIM2(1, 1));
+}
+
+TEST_CASE("Hyperplane pruning keeps the feasible set", "[internal::pruneDominatedHyperplanes]") {
+    using AlignedBox3 = rlss::internal::AlignedBox<double, 3U>;
+    using VectorDIM3 = rlss::internal::VectorDIM<double, 3U>;
+    using Hyperplane3 = rlss::internal::Hyperplane<double, 3U>;
+
+    AlignedBox3 box(VectorDIM3(-5, -5, -5), VectorDIM3(5, 5, 5));
+
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> dist(-1, 1);
+
+    std::vector<Hyperplane3> hps;
+    for(int i = 0; i < 100; i++) {
+        VectorDIM3 normal(dist(gen), dist(gen), dist(gen));
+        hps.emplace_back(normal, -4 - dist(gen));
+        hps.emplace_back(normal * 2, -8 - 2 * dist(gen));
+    }
+
+    std::vector<Hyperplane3> dominated
+        = rlss::internal::pruneDominatedHyperplanes<double, 3U>(hps, box);
+    std::vector<Hyperplane3> redundant
+        = rlss::internal::pruneRedundantHyperplanes<double, 3U>(
+                dominated, box);
+
+    REQUIRE(dominated.size() <= 100);
+    REQUIRE(redundant.size() <= dominated.size());
+
+    auto feasible = [](
+            const std::vector<Hyperplane3>& planes,
+            const VectorDIM3& pt
+    ) {
+        for(const auto& hp: planes) {
+            if(hp.signedDistance(pt) > 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for(int i = 0; i < 10000; i++) {
+        VectorDIM3 pt(5 * dist(gen), 5 * dist(gen), 5 * dist(gen));
+        bool expected = feasible(hps, pt);
+        REQUIRE(feasible(dominated, pt) == expected);
+        REQUIRE(feasible(redundant, pt) == expected);
+    }
+}
+
+TEST_CASE("Hyperplane pruning creates one LP solver per call", "[internal::pruneRedundantHyperplanes]") {
+    using AlignedBox2 = rlss::internal::AlignedBox<double, 2U>;
+    using VectorDIM2 = rlss::internal::VectorDIM<double, 2U>;
+    using Hyperplane2 = rlss::internal::Hyperplane<double, 2U>;
+    using QPSolver = rlss::internal::QPSolver<double>;
+    using Registry = rlss::internal::QPSolverRegistry<double>;
+
+    static int created = 0;
+    Registry::instance().registerSolver(
+        "counted_qpoases",
+        []() {
+            created++;
+            return rlss::internal::createQPSolver<double>("qpoases");
+        }
+    );
+
+    AlignedBox2 box(VectorDIM2(-5, -5), VectorDIM2(5, 5));
+    std::vector<Hyperplane2> hps {
+        Hyperplane2(VectorDIM2(1, 0), -1),
+        Hyperplane2(VectorDIM2(-1, 0), -1),
+        Hyperplane2(VectorDIM2(0, 1), -1),
+        Hyperplane2(VectorDIM2(0, -1), -1),
+        Hyperplane2(VectorDIM2(1, 1), -3)
+    };
+
+    rlss::internal::pruneRedundantHyperplanes<double, 2U>(
+            hps, box, "counted_qpoases");
+    REQUIRE(created == 1);
+
+    std::unique_ptr<QPSolver> solver
+        = rlss::internal::createQPSolver<double>("counted_qpoases");
+    created = 0;
+    rlss::internal::pruneRedundantHyperplanes<double, 2U>(
+            hps, box, "counted_qpoases", solver.get());
+    REQUIRE(created == 0);
+}
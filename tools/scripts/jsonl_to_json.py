@@ -0,0 +1,53 @@
+import sys
+import json
+
+# Converts all_stats.jsonl or vis.jsonl written with streaming_output to the
+# all_stats.json or vis.json the other tools read.
+#
+# usage: python3 jsonl_to_json.py input.jsonl output.json
+
+input_path = sys.argv[1]
+output_path = sys.argv[2]
+
+
+def convert_statistics(records):
+    stats = {}
+    for record in records:
+        record_type = record.pop("type")
+        if record_type == "summary":
+            stats.update(record)
+        elif record_type in ("duration_statistics",
+                             "success_failure_statistics"):
+            record.pop("source")
+            stats.setdefault(record_type, []).append(record)
+    return stats
+
+
+def convert_visualization(records):
+    vis = {}
+    frames = []
+    for record in records:
+        record_type = record.pop("type")
+        if record_type == "header":
+            vis.update(record)
+        elif record_type == "frame":
+            frames.append(record["frame"])
+    vis["frames"] = frames
+    return vis
+
+
+records = []
+f = open(input_path, "r")
+for line in f:
+    if line.strip():
+        records.append(json.loads(line))
+f.close()
+
+if records and records[0]["type"] == "header":
+    result = convert_visualization(records)
+else:
+    result = convert_statistics(records)
+
+f = open(output_path, "w")
+f.write(json.dumps(result))
+f.close()
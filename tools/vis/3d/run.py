@@ -6,12 +6,89 @@ readline.set_completer_delims(' \t\n')
 import os.path as op
 import glob as gb
 import json
+import math
 import threading
 import rospy
 
 def run_visualizer(vis):
     vis.run()
 
+def unpack_log(log):
+    # packed_cbor output stores frames as arrays in frame_layout order
+    # with vectors flattened, see jsonbuilder::pack
+    if log.get("encoding") != "packed":
+        return log
+    dim = log["dimension"]
+
+    def chunks(flat, size):
+        return [list(flat[i:i + size]) for i in range(0, len(flat), size)]
+
+    frames = []
+    for step, positions, trajectories, obstacles, hyperplanes in log["frames"]:
+        frame = {"step": step}
+        if positions is not None:
+            frame["robot_positions"] = [
+                {"robot_id": robot_id, "position": position}
+                for robot_id, position in enumerate(chunks(positions, dim))
+                if not math.isnan(position[0])
+            ]
+        if trajectories is not None:
+            frame["trajectories"] = []
+            for robot_id, pieces, path in trajectories:
+                traj = {
+                    "robot_id": robot_id,
+                    "trajectory": [
+                        {
+                            "type": "bezier",
+                            "max_parameter": max_parameter,
+                            "controlpoints": chunks(controlpoints, dim)
+                        }
+                        for max_parameter, controlpoints in pieces
+                    ]
+                }
+                if path is not None:
+                    traj["discrete_path"] = chunks(path, dim)
+                frame["trajectories"].append(traj)
+        if obstacles is not None:
+            boxes = chunks(obstacles, dim)
+            frame["obstacles"] = [
+                {"min": boxes[i], "max": boxes[i + 1]}
+                for i in range(0, len(boxes), 2)
+            ]
+        if hyperplanes is not None:
+            frame["hyperplanes"] = [
+                {
+                    "robot_id": robot_id,
+                    "hyperplanes": [
+                        {
+                            "piece_id": piece_id,
+                            "hyperplane": {
+                                "normal": values[:dim],
+                                "distance": values[dim]
+                            }
+                        }
+                        for piece_id, values
+                        in zip(piece_ids, chunks(flat, dim + 1))
+                    ]
+                }
+                for robot_id, piece_ids, flat in hyperplanes
+            ]
+        frames.append(frame)
+    log["frames"] = frames
+    return log
+
+def load_log(path):
+    # vis.cbor holds the same document as vis.json, possibly packed
+    if path.endswith(".cbor"):
+        import cbor2
+        f = open(path, "rb")
+        log = cbor2.loads(f.read())
+    else:
+        f = open(path, "r")
+        log = json.loads(f.read())
+    f.close()
+    return unpack_log(log)
+
 class VisualizerPrompt(Cmd):
     prompt = '3dvis> '
     intro = 'Type ? for commands'
@@ -29,9 +106,7 @@ class VisualizerPrompt(Cmd):
         except AttributeError:
             pass
 
-        f = open(inp, "r")
-        j = json.loads(f.read())
-        f.close()
+        j = load_log(inp)
 
         self.vis = Visualizer(j)
         self.command_queue = self.vis.command_queue